@@ -0,0 +1,394 @@
+/**
+ * @file TestCodecs.cpp
+ * @brief Test suite for the byte-exactness-critical codecs in src/api/base
+ *
+ * This file contains unit tests for the streaming codecs the HTTP stack
+ * depends on getting right byte for byte: the SSE event parser, the SAX
+ * JSON string extractor, the payload template splicer and the chunked
+ * JSON-escaping upload body. nlohmann/json serves as the escaping oracle
+ * throughout, since the codecs promise output identical to dump().
+ *
+ * @author PyClaudeCli Team
+ * @date 2024
+ */
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "api/base/SseParser.h"
+#include "api/base/JsonExtractor.h"
+#include "api/base/PayloadTemplate.h"
+#include "api/base/UploadBody.h"
+
+/**
+ * @class TestRunner
+ * @brief Test runner for the codec unit tests
+ *
+ * Manages test execution, reporting, and cleanup, mirroring the runner in
+ * TestVariableApi.cpp. A temporary directory isolates the files the upload
+ * body tests map.
+ */
+class TestRunner {
+private:
+    /**
+     * @brief Count of passed tests
+     */
+    int passed = 0;
+
+    /**
+     * @brief Count of failed tests
+     */
+    int failed = 0;
+
+    /**
+     * @brief Temporary directory path for test isolation
+     */
+    std::string test_dir;
+
+public:
+    /**
+     * @brief Construct a new Test Runner object
+     */
+    TestRunner() {
+        test_dir = "/tmp/cpp_codec_test_" + std::to_string(time(nullptr));
+        std::filesystem::create_directories(test_dir);
+    }
+
+    /**
+     * @brief Destroy the Test Runner object, removing the test directory
+     */
+    ~TestRunner() {
+        std::error_code ec;
+        std::filesystem::remove_all(test_dir, ec);
+    }
+
+    /**
+     * @brief Assert that a condition holds
+     *
+     * @param condition Condition under test
+     * @param message Description printed with the result
+     */
+    void assert_true(bool condition, const std::string& message) {
+        if (condition) {
+            std::cout << "PASS: " << message << std::endl;
+            ++passed;
+        } else {
+            std::cout << "FAIL: " << message << std::endl;
+            ++failed;
+        }
+    }
+
+    /**
+     * @brief Assert that two strings are equal
+     *
+     * @param actual Value produced by the code under test
+     * @param expected Value the test expects
+     * @param message Description printed with the result
+     */
+    void assert_equal(const std::string& actual, const std::string& expected,
+                      const std::string& message) {
+        if (actual == expected) {
+            std::cout << "PASS: " << message << std::endl;
+            ++passed;
+        } else {
+            std::cout << "FAIL: " << message << " (expected " << expected.size()
+                      << " bytes, got " << actual.size() << ")" << std::endl;
+            ++failed;
+        }
+    }
+
+    /**
+     * @brief JSON-escape a string the way nlohmann's dump() does
+     *
+     * @details
+     * Serializes the string through nlohmann and strips the surrounding
+     * quotes, giving an escaping oracle independent of the codecs under
+     * test.
+     */
+    static std::string escapeOracle(const std::string& text) {
+        auto dumped = nlohmann::json(text).dump();
+        return dumped.substr(1, dumped.size() - 2);
+    }
+
+    /**
+     * @brief Consume an upload body through read() in fixed-size chunks
+     *
+     * @param body Body to drain; the cursor is rewound first
+     * @param chunk Capacity handed to each read() call
+     */
+    static std::string drain(api::UploadBody& body, size_t chunk) {
+        body.rewind();
+        std::vector<char> buffer(chunk);
+        std::string out;
+        size_t n;
+        while ((n = body.read(buffer.data(), chunk)) > 0) {
+            out.append(buffer.data(), n);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Test the incremental SSE parser
+     *
+     * @details
+     * Covers event extraction, CRLF line endings, the optional space after
+     * "data:", ignored comment/event/blank lines, payloads arriving one
+     * byte at a time, and reset() dropping a partial line.
+     */
+    void test_sse_parser() {
+        std::cout << "\n=== SseParser Tests ===" << std::endl;
+
+        std::vector<std::string> events;
+        api::SseParser parser([&](const std::string& data) {
+            events.push_back(data);
+        });
+
+        // Test 1: Mixed stream fed a byte at a time, so every line and
+        // every event boundary is split across feeds
+        std::string stream = "event: delta\r\n"
+                             "data: one\n"
+                             "\n"
+                             "data:two\r\n"
+                             "\r\n"
+                             ": keepalive comment\n"
+                             "data: \n"
+                             "data: three\n";
+        for (char c : stream) {
+            parser.feed(&c, 1);
+        }
+        assert_true(events.size() == 3, "Byte-wise feed yields one event per data line");
+        if (events.size() == 3) {
+            assert_equal(events[0], "one", "Space after data: is stripped");
+            assert_equal(events[1], "two", "No space after data: is accepted");
+            assert_equal(events[2], "three", "Comments, event and blank lines are ignored");
+        }
+
+        // Test 2: A payload is not emitted until its newline arrives
+        events.clear();
+        std::string partial = "data: held";
+        parser.feed(partial.data(), partial.size());
+        assert_true(events.empty(), "Unterminated data line is buffered, not emitted");
+        parser.feed("\n", 1);
+        assert_true(events.size() == 1 && events[0] == "held",
+                    "Buffered line is emitted once terminated");
+
+        // Test 3: reset() drops a partial line
+        events.clear();
+        partial = "data: dropped";
+        parser.feed(partial.data(), partial.size());
+        parser.reset();
+        parser.feed("\n", 1);
+        assert_true(events.empty(), "reset() discards the partial line");
+    }
+
+    /**
+     * @brief Test the SAX JSON string extractor
+     *
+     * @details
+     * Covers the provider response shapes the clients actually pull from
+     * (object keys and array indexes mixed), misses, and malformed input.
+     */
+    void test_json_extractor() {
+        std::cout << "\n=== JsonExtractor Tests ===" << std::endl;
+
+        // Test 4: Anthropic shape - content[0].text
+        std::string body = R"({"id":"msg","content":[{"type":"text","text":"hello world"}]})";
+        auto result = api::extractJsonStringField(body, {"content", 0, "text"});
+        assert_true(result.found, "content[0].text is found");
+        assert_equal(result.value, "hello world", "content[0].text value matches");
+
+        // Test 5: Non-zero array index - choices[1].delta.content
+        body = R"({"choices":[{"delta":{"content":"first"}},{"delta":{"content":"second"}}]})";
+        result = api::extractJsonStringField(body, {"choices", 1, "delta", "content"});
+        assert_true(result.found, "choices[1].delta.content is found");
+        assert_equal(result.value, "second", "Second array element is selected");
+
+        // Test 6: Escapes in the document are decoded
+        body = R"({"text":"line\nbreak \"quoted\""})";
+        result = api::extractJsonStringField(body, {"text"});
+        assert_equal(result.value, "line\nbreak \"quoted\"",
+                     "Escaped characters are decoded in the extracted value");
+
+        // Test 7: Missing field is a miss, not an error
+        body = R"({"content":[{"type":"text"}]})";
+        result = api::extractJsonStringField(body, {"content", 0, "text"});
+        assert_true(!result.found && !result.parse_error,
+                    "Absent field reports not-found without a parse error");
+
+        // Test 8: Malformed document reports a parse error
+        body = R"({"content":[{)";
+        result = api::extractJsonStringField(body, {"content", 0, "text"});
+        assert_true(!result.found && result.parse_error,
+                    "Malformed document reports a parse error");
+    }
+
+    /**
+     * @brief Test the payload template splicer
+     *
+     * @details
+     * Compiles an envelope serialized by nlohmann with the slot sentinel as
+     * the message and checks that rendering reproduces, byte for byte, the
+     * document nlohmann would have produced with the real message.
+     */
+    void test_payload_template() {
+        std::cout << "\n=== PayloadTemplate Tests ===" << std::endl;
+
+        auto envelope = [](const std::string& message) {
+            nlohmann::json payload = {
+                {"model", "test-model"},
+                {"max_tokens", 256},
+                {"messages", nlohmann::json::array({
+                    {{"role", "user"}, {"content", message}}
+                })}
+            };
+            return payload.dump();
+        };
+
+        api::PayloadTemplate tmpl;
+        tmpl.compile(envelope(std::string(api::PayloadTemplate::kSlot)));
+        assert_true(tmpl.compiled(), "Envelope with one slot compiles");
+
+        // Test 9: Rendering matches nlohmann's serialization exactly,
+        // including escapes and control characters
+        std::string message = "He said \"hi\",\nthen left\ta \\note\x01 behind";
+        std::string rendered;
+        tmpl.render(message, rendered);
+        assert_equal(rendered, envelope(message),
+                     "Rendered payload matches nlohmann dump byte for byte");
+
+        // Test 10: The caller's buffer is replaced, not appended to
+        tmpl.render("fresh", rendered);
+        assert_equal(rendered, envelope("fresh"), "render() replaces the buffer contents");
+
+        // Test 11: A slotless envelope stays uncompiled
+        api::PayloadTemplate no_slot;
+        no_slot.compile(envelope("no sentinel here"));
+        assert_true(!no_slot.compiled(), "Envelope without the slot stays uncompiled");
+
+        // Test 12: A duplicated slot stays uncompiled
+        api::PayloadTemplate two_slots;
+        std::string twice = std::string(api::PayloadTemplate::kSlot) + " " +
+                            std::string(api::PayloadTemplate::kSlot);
+        two_slots.compile(envelope(twice));
+        assert_true(!two_slots.compiled(), "Envelope with two slots stays uncompiled");
+
+        // Test 13: reset() drops the compiled envelope
+        tmpl.reset();
+        assert_true(!tmpl.compiled(), "reset() drops the compiled envelope");
+    }
+
+    /**
+     * @brief Test the chunked JSON-escaping upload body
+     *
+     * @details
+     * Maps a document dense with characters that escape to 2 and 6 bytes,
+     * splices it between envelope literals, and drains the body through
+     * read() at chunk sizes from one byte up - so escape sequences are
+     * split across every possible buffer boundary - checking the output
+     * and contentLength() against the nlohmann oracle each time.
+     */
+    void test_upload_body() {
+        std::cout << "\n=== UploadBody Tests ===" << std::endl;
+
+        // A document where escapes land on every alignment: quotes,
+        // backslashes, newlines, tabs and low control characters mixed with
+        // plain runs and multi-byte UTF-8.
+        std::string document;
+        for (int i = 0; i < 512; ++i) {
+            document += "plain run ";
+            document += static_cast<char>('a' + (i % 26));
+            document += "\"\\\n\r\t\b\f";
+            document += static_cast<char>(1 + (i % 31));
+            document += "caf\xc3\xa9";
+        }
+
+        std::string doc_path = test_dir + "/document.txt";
+        {
+            std::ofstream out(doc_path, std::ios::binary);
+            out << document;
+        }
+
+        std::string prefix = "{\"messages\":[{\"role\":\"user\",\"content\":\"";
+        std::string suffix = "\"}]}";
+        std::string expected = prefix + escapeOracle(document) + suffix;
+
+        api::UploadBody body;
+        body.append(prefix);
+        body.appendJsonEscaped(api::MappedFile::open(doc_path));
+        body.append(suffix);
+
+        // Test 14: contentLength() agrees with the oracle before any read
+        assert_true(body.contentLength() == expected.size(),
+                    "contentLength() matches the escaped size");
+
+        // Test 15: Drained output matches at every awkward chunk size
+        for (size_t chunk : {size_t(1), size_t(2), size_t(3), size_t(7),
+                             size_t(64), size_t(4096), expected.size() + 1}) {
+            assert_equal(drain(body, chunk), expected,
+                         "Escaped stream matches oracle at chunk size " +
+                             std::to_string(chunk));
+        }
+
+        // Test 16: rewind() makes the body reusable after a full drain
+        assert_equal(drain(body, 1024), expected, "Body re-reads identically after rewind");
+
+        // Test 17: Raw file segments pass through verbatim
+        api::UploadBody raw;
+        raw.append("head:");
+        raw.appendFile(api::MappedFile::open(doc_path));
+        raw.append(":tail");
+        assert_equal(drain(raw, 313), "head:" + document + ":tail",
+                     "Raw mapped segment streams verbatim");
+        assert_true(raw.contentLength() == document.size() + 10,
+                    "Raw contentLength() counts unescaped bytes");
+
+        // Test 18: An empty mapped file contributes nothing
+        std::string empty_path = test_dir + "/empty.txt";
+        { std::ofstream out(empty_path); }
+        api::UploadBody with_empty;
+        with_empty.append("[");
+        with_empty.appendJsonEscaped(api::MappedFile::open(empty_path));
+        with_empty.append("]");
+        assert_equal(drain(with_empty, 8), "[]", "Empty mapped file contributes no bytes");
+    }
+
+    /**
+     * @brief Run all test suites and report results
+     *
+     * @return Number of failed tests
+     */
+    int run_all_tests() {
+        std::cout << "Running C++ Codec Tests" << std::endl;
+        std::cout << "=======================" << std::endl;
+
+        test_sse_parser();
+        test_json_extractor();
+        test_payload_template();
+        test_upload_body();
+
+        std::cout << "\nTest Results:" << std::endl;
+        std::cout << "Passed: " << passed << std::endl;
+        std::cout << "Failed: " << failed << std::endl;
+
+        if (failed == 0) {
+            std::cout << "All tests passed!" << std::endl;
+        }
+
+        return failed;
+    }
+};
+
+/**
+ * @brief Main entry point for the codec test suite
+ *
+ * @return 0 when every test passes, 1 otherwise
+ */
+int main() {
+    TestRunner runner;
+    return runner.run_all_tests() > 0 ? 1 : 0;
+}
@@ -223,6 +223,62 @@ public:
             assert_equal(vm4.GetVariable("var2"), "value2", "Multiple variables persist - var2");
             assert_equal(vm4.GetVariable("var3"), "value3", "Multiple variables persist - var3");
         }
+
+        // Test 8b: A burst of sets larger than the write-behind batch
+        // persists through the log across a restart
+        {
+            VariableManager vm5(test_dir);
+            for (int i = 0; i < 200; ++i) {
+                vm5.SetVariable("burst_" + std::to_string(i), std::to_string(i));
+            }
+        }
+
+        {
+            VariableManager vm6(test_dir);
+            assert_equal(vm6.GetVariable("burst_0"), "0", "Burst writes persist - first");
+            assert_equal(vm6.GetVariable("burst_199"), "199", "Burst writes persist - last");
+        }
+
+        // Test 8c: Log records whose generation header does not match the
+        // snapshot on disk are stale (the snapshot was rewritten after the
+        // records, e.g. by the Python side following a crash) and must be
+        // discarded rather than replayed over the newer document
+        {
+            std::ofstream log(test_dir + "/variables.log", std::ios::trunc);
+            log << "{\"g\":1}\n{\"n\":\"stale_check\",\"v\":\"from_stale_log\"}\n";
+        }
+        {
+            std::ofstream json(test_dir + "/variables.json", std::ios::trunc);
+            json << "{\n  \"stale_check\": \"from_snapshot\"\n}";
+        }
+        {
+            VariableManager vm7(test_dir);
+            assert_equal(vm7.GetVariable("stale_check"), "from_snapshot",
+                         "Stale log records do not clobber a newer snapshot");
+        }
+
+        // Test 8d: Records bearing the snapshot's current generation are
+        // replayed on top of it
+        {
+            {
+                std::ofstream json(test_dir + "/variables.json", std::ios::trunc);
+                json << "{\n  \"replay_check\": \"from_snapshot\"\n}";
+            }
+            struct stat info;
+            assert_true(stat((test_dir + "/variables.json").c_str(), &info) == 0,
+                        "Snapshot stat for generation header");
+            long long generation =
+                static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL +
+                info.st_mtim.tv_nsec;
+            {
+                std::ofstream log(test_dir + "/variables.log", std::ios::trunc);
+                log << "{\"g\":" << generation << "}\n"
+                    << "{\"n\":\"replay_check\",\"v\":\"from_log\"}\n";
+            }
+            VariableManager vm8(test_dir);
+            assert_equal(vm8.GetVariable("replay_check"), "from_log",
+                         "Current-generation log records replay over the snapshot");
+        }
     }
     
     /**
@@ -0,0 +1,164 @@
+/**
+ * @file ApiModule.cpp
+ * @brief pybind11 module exposing the C++ transport to the Python CLI
+ *
+ * This file builds the `ask_native` extension module, which lets the Python
+ * CLI send provider requests through the pooled, HTTP/2-multiplexed C++
+ * transport in src/api instead of re-implementing HTTP in Python.
+ *
+ * @author PyClaudeCli Team
+ * @date 2025
+ *
+ * @details
+ * The module wraps ApiFactory together with the ConfigManager it needs, so
+ * Python sees a single NativeApi object constructed from a config path.
+ * Blocking calls release the GIL for the duration of the network wait and
+ * reacquire it only to build the result, so Python threads keep running
+ * while a request is in flight. Response bodies are moved (not copied)
+ * from the transport into the returned objects.
+ *
+ * Built only when pybind11 is installed; see CMakeLists.txt in this
+ * directory.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
+#include <pybind11/stl.h>
+
+#include "api/factory/ApiFactory.h"
+#include "config/ConfigManager.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace {
+
+/**
+ * @class NativeApi
+ * @brief Python-facing facade over ConfigManager + ApiFactory
+ *
+ * @details
+ * ApiFactory borrows its ConfigManager by reference, so the wrapper owns
+ * both and keeps their lifetimes tied to the Python object. Clients are
+ * cached per provider inside the factory, so repeated sends from Python
+ * reuse warm connections.
+ */
+class NativeApi {
+public:
+    explicit NativeApi(const std::string& config_path)
+        : config_manager_(config_path), factory_(config_manager_) {}
+
+    /**
+     * @brief Sends a single message and blocks until the response arrives.
+     *
+     * The GIL is released while the transfer is in flight.
+     */
+    py::dict send(const std::string& provider,
+                  const std::string& message,
+                  const std::string& model,
+                  int max_tokens,
+                  double temperature) {
+        api::MessageRequest request = makeRequest(message, model, max_tokens, temperature);
+
+        api::ApiResponse response;
+        {
+            py::gil_scoped_release release;
+            response = factory_.getClient(provider)->sendMessage(request);
+        }
+        return toDict(std::move(response));
+    }
+
+    /**
+     * @brief Streams a response, invoking `on_chunk` per content delta.
+     *
+     * The GIL is released for the transfer and reacquired around each
+     * callback into Python, so chunk handlers may touch Python state.
+     */
+    py::dict sendStream(const std::string& provider,
+                        const std::string& message,
+                        const py::function& on_chunk,
+                        const std::string& model,
+                        int max_tokens,
+                        double temperature) {
+        api::MessageRequest request = makeRequest(message, model, max_tokens, temperature);
+
+        api::ApiResponse response;
+        {
+            py::gil_scoped_release release;
+            response = factory_.getClient(provider)->sendMessageStream(
+                request, [&on_chunk](const std::string& chunk) {
+                    py::gil_scoped_acquire acquire;
+                    on_chunk(py::str(chunk));
+                });
+        }
+        return toDict(std::move(response));
+    }
+
+    /// @brief Providers that are both compiled in and configured.
+    std::vector<std::string> providers() const {
+        return factory_.getAvailableProviders();
+    }
+
+    /// @brief Model identifiers offered by the provider (cached on disk).
+    std::vector<std::string> models(const std::string& provider) {
+        py::gil_scoped_release release;
+        return factory_.getClient(provider)->getAvailableModels();
+    }
+
+private:
+    static api::MessageRequest makeRequest(const std::string& message,
+                                           const std::string& model,
+                                           int max_tokens,
+                                           double temperature) {
+        api::MessageRequest request;
+        request.message = message;
+        request.model = model;
+        request.max_tokens = max_tokens;
+        request.temperature = temperature;
+        return request;
+    }
+
+    /// @brief Converts an ApiResponse into the dict shape the CLI expects.
+    static py::dict toDict(api::ApiResponse response) {
+        py::dict result;
+        result["success"] = response.success;
+        result["status_code"] = response.status_code;
+        result["content"] = py::str(std::move(response.content));
+        if (!response.error_message.empty()) {
+            result["error"] = py::str(std::move(response.error_message));
+        }
+        return result;
+    }
+
+    config::ConfigManager config_manager_;
+    api::ApiFactory factory_;
+};
+
+} // namespace
+
+PYBIND11_MODULE(ask_native, m) {
+    m.doc() = "Native transport for the ask CLI: provider requests routed "
+              "through the pooled, HTTP/2-multiplexed C++ client.";
+
+    py::class_<NativeApi>(m, "NativeApi")
+        .def(py::init<const std::string&>(), py::arg("config_path"),
+             "Loads configuration and prepares the provider factory.")
+        .def("send", &NativeApi::send,
+             py::arg("provider"), py::arg("message"),
+             py::arg("model") = "", py::arg("max_tokens") = 0,
+             py::arg("temperature") = -1.0,
+             "Sends a message and returns a response dict; the GIL is "
+             "released while the request is in flight.")
+        .def("send_stream", &NativeApi::sendStream,
+             py::arg("provider"), py::arg("message"), py::arg("on_chunk"),
+             py::arg("model") = "", py::arg("max_tokens") = 0,
+             py::arg("temperature") = -1.0,
+             "Streams a response, calling on_chunk(str) per content delta.")
+        .def("providers", &NativeApi::providers,
+             "Providers that are compiled in and configured.")
+        .def("models", &NativeApi::models, py::arg("provider"),
+             "Model identifiers offered by the provider.");
+}
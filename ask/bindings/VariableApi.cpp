@@ -1,38 +1,55 @@
 /**
  * @file VariableApi.cpp
  * @brief C++ API for PyClaudeCli Variable Management System
- * 
- * This file provides a C++ interface to the Python-based variable management
- * system. It allows C++ applications to interact with the variable storage
- * through a clean API that internally uses Python for actual operations.
- * 
+ *
+ * This file provides a native C++ implementation of the variable management
+ * system. It reads and writes the same variables.json format as the Python
+ * VariableManager, so both sides stay interchangeable.
+ *
  * @author PyClaudeCli Team
  * @date 2024
- * 
+ *
  * @details
- * The implementation uses popen() to execute Python commands, ensuring
- * compatibility with the existing Python variable system while providing
- * native C++ access.
+ * The implementation keeps the parsed JSON document in memory and only
+ * rewrites the storage file on mutation, so reads are pure in-process
+ * lookups with no interpreter or subprocess involved.
  */
 
 #include <string>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
 
 /**
  * @class VariableManager
  * @brief C++ interface for managing persistent variables
- * 
- * This class provides a C++ wrapper around the Python VariableManager,
- * allowing C++ applications to store, retrieve, and manage variables
- * that persist across sessions.
- * 
+ *
+ * This class provides native storage, retrieval, and listing of variables
+ * that persist across sessions, sharing its on-disk format with the Python
+ * VariableManager in ask/utils/variables.py.
+ *
  * @details
- * The class uses the Python interpreter to execute commands from the
- * ai.utils.variables module, ensuring consistency with the Python API.
- * All variable operations are thread-safe at the Python level.
- * 
+ * Variables are loaded once at construction and served from memory, so
+ * reads never touch disk. Writes go through a write-behind buffer into an
+ * append-only memory-mapped log (variables.log) and are coalesced, so a
+ * burst of sets costs one flush instead of a full-document rewrite each.
+ * The log is periodically compacted into variables.json - and always on
+ * destruction - which remains the canonical format the Python side reads.
+ * Save failures (e.g. an unwritable directory) are swallowed so callers
+ * are never disrupted, matching the Python implementation's behaviour.
+ *
  * Example usage:
  * @code{.cpp}
  * VariableManager vm;
@@ -47,81 +64,388 @@ private:
      * @brief Path to the variable storage JSON file
      */
     std::string config_path;
-    
+
+    /**
+     * @brief Path to the append-only mutation log next to the JSON file
+     */
+    std::string log_path;
+
+    /**
+     * @brief In-memory copy of the parsed variables document
+     */
+    nlohmann::json variables;
+
+    /// @brief Sets buffered but not yet flushed to the log, oldest first
+    std::vector<std::string> write_buffer;
+
+    /// @brief Log file descriptor, or -1 when the log is unavailable
+    int log_fd = -1;
+
+    /// @brief Mapped log region, or nullptr when the log is unavailable
+    char* log_map = nullptr;
+
+    /// @brief Mapped capacity in bytes
+    size_t log_capacity = 0;
+
+    /// @brief Bytes of valid records at the front of the mapping
+    size_t log_offset = 0;
+
+    /// @brief Records appended to the log since the last compaction
+    size_t log_records = 0;
+
+    /// @brief Buffered sets coalesced into one flush
+    static constexpr size_t kFlushThreshold = 64;
+
+    /// @brief Log records that trigger compaction into the JSON snapshot
+    static constexpr size_t kCompactThreshold = 1024;
+
+    /// @brief Growth unit for the mapped log file
+    static constexpr size_t kMapChunk = 64 * 1024;
+
+    /**
+     * @brief Nanosecond mtime of the JSON snapshot, or 0 when absent
+     *
+     * @details
+     * Serves as the snapshot generation recorded in the log header: any
+     * rewrite of variables.json (including by the Python side) changes it,
+     * which is exactly the signal that surviving log records are stale.
+     */
+    long long snapshot_generation() const {
+        struct stat info;
+        if (stat(config_path.c_str(), &info) != 0) {
+            return 0;
+        }
+        return static_cast<long long>(info.st_mtim.tv_sec) * 1000000000LL +
+               info.st_mtim.tv_nsec;
+    }
+
+    /**
+     * @brief Load variables from the storage file into memory
+     *
+     * @details
+     * A missing file or unparseable content initializes an empty document
+     * rather than failing, mirroring the Python loader.
+     */
+    void load_variables() {
+        variables = nlohmann::json::object();
+
+        std::ifstream file(config_path);
+        if (!file.is_open()) {
+            return;
+        }
+
+        try {
+            file >> variables;
+            if (!variables.is_object()) {
+                variables = nlohmann::json::object();
+            }
+        } catch (const nlohmann::json::exception&) {
+            variables = nlohmann::json::object();
+        }
+    }
+
     /**
-     * @brief Execute a Python command and return its output
-     * 
-     * @param cmd Python code to execute
-     * @return Command output as string
-     * 
+     * @brief Persist the in-memory document to the storage file
+     *
      * @details
-     * This method handles the execution of Python commands through popen(),
-     * manages the Python path, and captures the output. It automatically
-     * strips trailing newlines from the output.
-     * 
-     * @note The method changes directory to the project root to ensure
-     *       proper Python module imports.
+     * Creates parent directories as needed and writes the document with
+     * two-space indentation, the same layout the Python side produces.
+     * Errors are swallowed silently to avoid disrupting program flow.
      */
-    std::string execute_python_command(const std::string& cmd) const {
-        // Ensure we're using the project root as the Python path
-        std::string project_root = std::string(getenv("PWD"));
-        // If we're in a subdirectory, find the project root
-        size_t build_pos = project_root.find("/build");
-        if (build_pos != std::string::npos) {
-            project_root = project_root.substr(0, build_pos);
-        }
-        
-        std::string python_cmd = "cd " + project_root + " && python3 -c \"" + cmd + "\"";
-        
-        FILE* pipe = popen(python_cmd.c_str(), "r");
-        if (!pipe) return "";
-        
-        char buffer[128];
-        std::string result = "";
-        while (!feof(pipe)) {
-            if (fgets(buffer, 128, pipe) != nullptr) {
-                result += buffer;
+    void save_variables() const {
+        std::error_code ec;
+        std::filesystem::path path(config_path);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        std::ofstream file(config_path);
+        if (!file.is_open()) {
+            return;
+        }
+
+        file << variables.dump(2);
+    }
+
+    /**
+     * @brief Open and map the append-only log, replaying surviving records
+     *
+     * @details
+     * The log holds one JSON object per line ({"n": name, "v": value});
+     * the file is kept zero-filled past the last record, so valid data
+     * runs up to the first NUL byte. Records written after the snapshot
+     * are replayed over the loaded document. Any failure leaves the log
+     * disabled and the manager falls back to snapshot-only persistence.
+     */
+    void open_log() {
+        std::error_code ec;
+        std::filesystem::path path(log_path);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), ec);
+        }
+
+        log_fd = ::open(log_path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (log_fd < 0) {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(log_fd, &info) != 0) {
+            close_log();
+            return;
+        }
+
+        log_capacity = static_cast<size_t>(info.st_size);
+        if (log_capacity < kMapChunk) {
+            log_capacity = kMapChunk;
+            if (ftruncate(log_fd, static_cast<off_t>(log_capacity)) != 0) {
+                close_log();
+                return;
             }
         }
-        pclose(pipe);
-        
-        // Remove trailing newline
-        if (!result.empty() && result.back() == '\n') {
-            result.pop_back();
+
+        void* mapped = mmap(nullptr, log_capacity, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, log_fd, 0);
+        if (mapped == MAP_FAILED) {
+            close_log();
+            return;
+        }
+        log_map = static_cast<char*>(mapped);
+
+        replay_log();
+    }
+
+    /**
+     * @brief Apply logged records on top of the loaded snapshot
+     *
+     * @details
+     * The first line of a non-empty log is a generation header ({"g": N})
+     * recording the snapshot's mtime when the log was (re)started. Records
+     * are replayed only when that generation still matches the snapshot on
+     * disk: if variables.json has been rewritten since — say the Python
+     * side saved after a crash left records behind — the surviving records
+     * predate the document and replaying them would clobber the newer
+     * writes, so the log is discarded instead. Headerless logs (from
+     * before generations were recorded) are discarded the same way.
+     */
+    void replay_log() {
+        size_t end = 0;
+        while (end < log_capacity && log_map[end] != '\0') {
+            ++end;
+        }
+        if (end == 0) {
+            return;
+        }
+
+        size_t header_end = 0;
+        while (header_end < end && log_map[header_end] != '\n') {
+            ++header_end;
         }
-        
-        return result;
+
+        bool current = false;
+        try {
+            auto header = nlohmann::json::parse(log_map, log_map + header_end);
+            current = header.contains("g") && header["g"].is_number() &&
+                      header["g"].get<long long>() == snapshot_generation();
+        } catch (const nlohmann::json::exception&) {
+            // Not a header; fall through to the discard below.
+        }
+        if (!current || header_end >= end) {
+            std::memset(log_map, 0, end);
+            msync(log_map, end, MS_ASYNC);
+            return;
+        }
+
+        size_t line_start = header_end + 1;
+        for (size_t i = line_start; i < end; ++i) {
+            if (log_map[i] != '\n') {
+                continue;
+            }
+            try {
+                auto record = nlohmann::json::parse(log_map + line_start, log_map + i);
+                if (record.contains("n") && record["n"].is_string()) {
+                    variables[record["n"].get<std::string>()] = record["v"];
+                }
+            } catch (const nlohmann::json::exception&) {
+                // A torn trailing record (e.g. after a crash) is dropped.
+            }
+            line_start = i + 1;
+            ++log_records;
+        }
+        log_offset = line_start;
+    }
+
+    /**
+     * @brief Unmap and close the log, disabling logged persistence
+     */
+    void close_log() {
+        if (log_map) {
+            munmap(log_map, log_capacity);
+            log_map = nullptr;
+        }
+        if (log_fd >= 0) {
+            ::close(log_fd);
+            log_fd = -1;
+        }
+        log_capacity = 0;
+        log_offset = 0;
+        log_records = 0;
+    }
+
+    /**
+     * @brief Grow the mapping so at least `needed` more bytes fit
+     *
+     * @return true when the mapping has room for the append
+     */
+    bool ensure_capacity(size_t needed) {
+        if (log_offset + needed <= log_capacity) {
+            return true;
+        }
+
+        size_t new_capacity = log_capacity;
+        while (log_offset + needed > new_capacity) {
+            new_capacity += kMapChunk;
+        }
+
+        munmap(log_map, log_capacity);
+        log_map = nullptr;
+        if (ftruncate(log_fd, static_cast<off_t>(new_capacity)) != 0) {
+            close_log();
+            return false;
+        }
+        void* mapped = mmap(nullptr, new_capacity, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, log_fd, 0);
+        if (mapped == MAP_FAILED) {
+            close_log();
+            return false;
+        }
+        log_map = static_cast<char*>(mapped);
+        log_capacity = new_capacity;
+        return true;
+    }
+
+    /**
+     * @brief Copy the write-behind buffer into the mapped log in one pass
+     *
+     * @details
+     * A burst of sets lands here as a single memcpy per flush rather than
+     * a full-document rewrite per set. Once the log accumulates
+     * kCompactThreshold records it is folded into the JSON snapshot and
+     * truncated. Without a usable log the snapshot is written directly.
+     */
+    void flush_log() {
+        if (write_buffer.empty()) {
+            return;
+        }
+
+        if (!log_map) {
+            write_buffer.clear();
+            save_variables();
+            return;
+        }
+
+        // A fresh (or just-compacted) log opens with the generation header
+        // replay_log() checks records against; see its notes on staleness.
+        std::string header;
+        if (log_offset == 0) {
+            header = "{\"g\":" + std::to_string(snapshot_generation()) + "}\n";
+        }
+
+        size_t bytes = header.size();
+        for (const auto& record : write_buffer) {
+            bytes += record.size();
+        }
+
+        if (!ensure_capacity(bytes)) {
+            write_buffer.clear();
+            save_variables();
+            return;
+        }
+
+        if (!header.empty()) {
+            std::memcpy(log_map + log_offset, header.data(), header.size());
+            log_offset += header.size();
+        }
+
+        for (const auto& record : write_buffer) {
+            std::memcpy(log_map + log_offset, record.data(), record.size());
+            log_offset += record.size();
+            ++log_records;
+        }
+        msync(log_map, log_offset, MS_ASYNC);
+        write_buffer.clear();
+
+        if (log_records >= kCompactThreshold) {
+            compact();
+        }
+    }
+
+    /**
+     * @brief Fold the log into variables.json and reset the log
+     */
+    void compact() {
+        save_variables();
+        if (log_map) {
+            std::memset(log_map, 0, log_offset);
+            msync(log_map, log_offset, MS_ASYNC);
+        }
+        log_offset = 0;
+        log_records = 0;
     }
 
 public:
     /**
      * @brief Construct a new Variable Manager object
-     * 
+     *
      * @param config_dir Optional custom directory for variable storage.
      *                   If empty, defaults to ~/.config/claude/
-     * 
+     *
      * @details
      * Initializes the variable manager with either a custom storage location
-     * or the default location in the user's home directory.
+     * or the default location in the user's home directory, then loads any
+     * existing variables into memory.
      */
     VariableManager(const std::string& config_dir = "") {
+        std::string base;
         if (config_dir.empty()) {
-            config_path = std::string(getenv("HOME")) + "/.config/claude/variables.json";
+            base = std::string(getenv("HOME")) + "/.config/claude";
         } else {
-            config_path = config_dir + "/variables.json";
+            base = config_dir;
         }
+        config_path = base + "/variables.json";
+        log_path = base + "/variables.log";
+        load_variables();
+        open_log();
     }
-    
+
+    /**
+     * @brief Flush pending writes and compact the log into the snapshot
+     *
+     * @details
+     * Destruction leaves variables.json canonical and the log empty, so
+     * the Python side and the next manager instance see every set.
+     */
+    ~VariableManager() {
+        flush_log();
+        if (log_records > 0) {
+            compact();
+        }
+        close_log();
+    }
+
+    VariableManager(const VariableManager&) = delete;
+    VariableManager& operator=(const VariableManager&) = delete;
+
     /**
      * @brief Get the value of a variable
-     * 
+     *
      * @param name Variable name to retrieve
      * @return Variable value as string, empty string if not found
-     * 
+     *
      * @details
-     * Retrieves a variable value from persistent storage. The method
-     * properly escapes the variable name to prevent injection attacks.
-     * 
+     * String values are returned verbatim; values the Python side stored as
+     * other JSON types (numbers, objects, ...) are returned serialized.
+     *
      * @code{.cpp}
      * std::string value = vm.GetVariable("api_key");
      * if (!value.empty()) {
@@ -130,87 +454,67 @@ public:
      * @endcode
      */
     std::string GetVariable(const std::string& name) const {
-        std::string escaped_path = config_path;
-        std::string escaped_name = name;
-        // Escape single quotes
-        size_t pos = 0;
-        while ((pos = escaped_path.find("'", pos)) != std::string::npos) {
-            escaped_path.replace(pos, 1, "\\'");
-            pos += 2;
-        }
-        pos = 0;
-        while ((pos = escaped_name.find("'", pos)) != std::string::npos) {
-            escaped_name.replace(pos, 1, "\\'");
-            pos += 2;
-        }
-        
-        std::string python_code = 
-            "from AI.Utils.variables import VariableManager; "
-            "vm = VariableManager('" + escaped_path + "'); "
-            "value = vm.get_variable('" + escaped_name + "'); "
-            "print(value if value is not None else '', end='')";
-        
-        return execute_python_command(python_code);
+        auto it = variables.find(name);
+        if (it == variables.end()) {
+            return "";
+        }
+        if (it->is_string()) {
+            return it->get<std::string>();
+        }
+        return it->dump();
     }
-    
+
     /**
      * @brief Set or update a variable value
-     * 
+     *
      * @param name Variable name (must be valid identifier)
      * @param value Variable value to store
      * @return true if successfully set, false otherwise
-     * 
+     *
      * @details
-     * Stores a variable with the given name and value. The value is
-     * stored as a string but can represent JSON data. All values are
-     * properly escaped to prevent injection.
-     * 
+     * Stores a variable with the given name and value. Persistence is
+     * write-behind: the set is appended to an in-memory buffer that is
+     * flushed to the mapped log in batches, so bursts of sets coalesce
+     * into one flush. The value is stored as a string but can represent
+     * JSON data.
+     *
      * @code{.cpp}
      * if (vm.SetVariable("theme", "dark")) {
      *     std::cout << "Theme updated" << std::endl;
      * }
      * @endcode
      */
-    bool SetVariable(const std::string& name, const std::string& value) const {
-        std::string escaped_path = config_path;
-        std::string escaped_name = name;
-        std::string escaped_value = value;
-        // Escape single quotes
-        size_t pos = 0;
-        while ((pos = escaped_path.find("'", pos)) != std::string::npos) {
-            escaped_path.replace(pos, 1, "\\'");
-            pos += 2;
-        }
-        pos = 0;
-        while ((pos = escaped_name.find("'", pos)) != std::string::npos) {
-            escaped_name.replace(pos, 1, "\\'");
-            pos += 2;
-        }
-        pos = 0;
-        while ((pos = escaped_value.find("'", pos)) != std::string::npos) {
-            escaped_value.replace(pos, 1, "\\'");
-            pos += 2;
-        }
-        
-        std::string python_code = 
-            "from AI.Utils.variables import VariableManager; "
-            "vm = VariableManager('" + escaped_path + "'); "
-            "vm.set_variable('" + escaped_name + "', '" + escaped_value + "'); "
-            "print('success', end='')";
-        
-        std::string result = execute_python_command(python_code);
-        return result == "success";
+    bool SetVariable(const std::string& name, const std::string& value) {
+        variables[name] = value;
+
+        nlohmann::json record = {{"n", name}, {"v", value}};
+        write_buffer.push_back(record.dump() + "\n");
+        if (write_buffer.size() >= kFlushThreshold) {
+            flush_log();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Force pending writes to durable storage
+     *
+     * @details
+     * Flushes the write-behind buffer into the log immediately instead of
+     * waiting for the batch threshold or destruction.
+     */
+    void Flush() {
+        flush_log();
     }
-    
+
     /**
      * @brief List all stored variables
-     * 
+     *
      * @return JSON string containing all variables and their values
-     * 
+     *
      * @details
      * Returns a JSON-formatted string containing all stored variables.
      * The format is a JSON object with variable names as keys.
-     * 
+     *
      * @code{.cpp}
      * std::string vars_json = vm.ListVariables();
      * std::cout << "All variables: " << vars_json << std::endl;
@@ -218,21 +522,7 @@ public:
      * @endcode
      */
     std::string ListVariables() const {
-        std::string escaped_path = config_path;
-        // Escape single quotes
-        size_t pos = 0;
-        while ((pos = escaped_path.find("'", pos)) != std::string::npos) {
-            escaped_path.replace(pos, 1, "\\'");
-            pos += 2;
-        }
-        
-        std::string python_code = 
-            "from AI.Utils.variables import VariableManager; "
-            "import json; "
-            "vm = VariableManager('" + escaped_path + "'); "
-            "print(json.dumps(vm.list_variables()), end='')";
-        
-        return execute_python_command(python_code);
+        return variables.dump();
     }
 };
 
@@ -245,32 +535,32 @@ public:
 extern "C" {
     /**
      * @brief Create a new variable manager instance
-     * 
+     *
      * @param config_dir Optional configuration directory path
      * @return Pointer to new VariableManager instance
-     * 
+     *
      * @note Caller is responsible for calling destroy_variable_manager()
      */
     VariableManager* create_variable_manager(const char* config_dir) {
         return new VariableManager(config_dir ? config_dir : "");
     }
-    
+
     /**
      * @brief Destroy a variable manager instance
-     * 
+     *
      * @param vm Pointer to VariableManager to destroy
      */
     void destroy_variable_manager(VariableManager* vm) {
         delete vm;
     }
-    
+
     /**
      * @brief Get a variable value (C interface)
-     * 
+     *
      * @param vm VariableManager instance
      * @param name Variable name
      * @return Variable value as C string
-     * 
+     *
      * @warning The returned string is statically allocated and will be
      *          overwritten by subsequent calls
      */
@@ -279,10 +569,10 @@ extern "C" {
         result = vm->GetVariable(name);
         return result.c_str();
     }
-    
+
     /**
      * @brief Set a variable value (C interface)
-     * 
+     *
      * @param vm VariableManager instance
      * @param name Variable name
      * @param value Variable value
@@ -291,13 +581,13 @@ extern "C" {
     int set_variable(VariableManager* vm, const char* name, const char* value) {
         return vm->SetVariable(name, value) ? 1 : 0;
     }
-    
+
     /**
      * @brief List all variables (C interface)
-     * 
+     *
      * @param vm VariableManager instance
      * @return JSON string of all variables
-     * 
+     *
      * @warning The returned string is statically allocated and will be
      *          overwritten by subsequent calls
      */
@@ -312,27 +602,27 @@ extern "C" {
 #ifndef SKIP_MAIN
 /**
  * @brief Example usage and test program
- * 
+ *
  * @return 0 on success
- * 
+ *
  * @details
  * This main function demonstrates basic usage of the VariableManager class.
  * It can be excluded by defining SKIP_MAIN during compilation.
  */
 int main() {
     VariableManager vm;
-    
+
     // Set a variable
     vm.SetVariable("cpp_test", "Hello from C++");
-    
+
     // Get a variable
     std::string value = vm.GetVariable("a");
     std::cout << "Variable 'a' = " << value << std::endl;
-    
+
     // List all variables
     std::string all_vars = vm.ListVariables();
     std::cout << "All variables: " << all_vars << std::endl;
-    
+
     return 0;
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,337 @@
+#include "AsyncHttpClient.h"
+#include "BufferPool.h"
+#include "CurlShare.h"
+#include "RateLimiter.h"
+#include "Telemetry.h"
+#include "ApiException.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace api {
+
+namespace {
+
+size_t transferWriteCallback(void* contents, size_t size, size_t nmemb, std::string* body) {
+    size_t total_size = size * nmemb;
+    body->append(static_cast<char*>(contents), total_size);
+    return total_size;
+}
+
+// Never reserve more than this from a Content-Length header, however large
+// the server claims the body will be.
+constexpr size_t kMaxReserveBytes = 64 * 1024 * 1024;
+
+bool equalsIgnoreCase(const std::string& a, const char* b) {
+    size_t i = 0;
+    for (; i < a.size() && b[i] != '\0'; ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) !=
+            std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return i == a.size() && b[i] == '\0';
+}
+
+} // namespace
+
+AsyncHttpClient::AsyncHttpClient()
+    : multi_(nullptr), running_(true) {
+    multi_ = curl_multi_init();
+    if (!multi_) {
+        throw ConnectionException("Failed to initialize CURL multi handle");
+    }
+    // Let concurrent transfers to the same host ride one HTTP/2 connection
+    // as separate streams instead of opening a connection each.
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    worker_ = std::thread(&AsyncHttpClient::run, this);
+}
+
+AsyncHttpClient::~AsyncHttpClient() {
+    running_ = false;
+    curl_multi_wakeup(multi_);
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    curl_multi_cleanup(multi_);
+}
+
+std::future<HttpResponse> AsyncHttpClient::submit(const HttpRequest& request) {
+    auto transfer = makeTransfer(request);
+    auto future = transfer->promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi_);
+
+    return future;
+}
+
+void AsyncHttpClient::submit(const HttpRequest& request, CompletionCallback on_complete) {
+    auto transfer = makeTransfer(request);
+    transfer->on_complete = std::move(on_complete);
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_.push_back(std::move(transfer));
+    }
+    curl_multi_wakeup(multi_);
+}
+
+void AsyncHttpClient::setMaxConnections(int max_connections) {
+    if (max_connections > 0) {
+        curl_multi_setopt(multi_, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                          static_cast<long>(max_connections));
+    }
+}
+
+void AsyncHttpClient::setMaxHostConnections(int max_host_connections) {
+    if (max_host_connections > 0) {
+        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                          static_cast<long>(max_host_connections));
+    }
+}
+
+std::unique_ptr<AsyncHttpClient::Transfer> AsyncHttpClient::makeTransfer(const HttpRequest& request) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->request = request;
+
+    // Bodies append into recycled buffers so steady-state requests reuse
+    // capacity grown by earlier responses.
+    transfer->response_body = BufferPool::shared().acquire();
+
+    transfer->easy = curl_easy_init();
+    if (!transfer->easy) {
+        throw ConnectionException("Failed to initialize CURL handle for async transfer");
+    }
+
+    setupTransfer(*transfer);
+    return transfer;
+}
+
+AsyncHttpClient& AsyncHttpClient::shared() {
+    static AsyncHttpClient engine;
+    return engine;
+}
+
+void AsyncHttpClient::run() {
+    std::vector<std::unique_ptr<Transfer>> active;
+
+    while (running_ || !active.empty()) {
+        addPendingTransfers(active);
+
+        int still_running = 0;
+        curl_multi_perform(multi_, &still_running);
+
+        CURLMsg* msg;
+        int msgs_left;
+        while ((msg = curl_multi_info_read(multi_, &msgs_left)) != nullptr) {
+            if (msg->msg == CURLMSG_DONE) {
+                completeTransfer(active, msg->easy_handle, msg->data.result);
+            }
+        }
+
+        if (running_ || !active.empty()) {
+            int numfds = 0;
+            curl_multi_poll(multi_, nullptr, 0, 1000, &numfds);
+        }
+    }
+}
+
+void AsyncHttpClient::addPendingTransfers(std::vector<std::unique_ptr<Transfer>>& active) {
+    std::vector<std::unique_ptr<Transfer>> submitted;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        submitted.swap(pending_);
+    }
+
+    for (auto& transfer : submitted) {
+        curl_multi_add_handle(multi_, transfer->easy);
+        active.push_back(std::move(transfer));
+    }
+}
+
+void AsyncHttpClient::completeTransfer(std::vector<std::unique_ptr<Transfer>>& active,
+                                       CURL* easy, CURLcode result) {
+    auto it = std::find_if(active.begin(), active.end(),
+                           [easy](const std::unique_ptr<Transfer>& t) { return t->easy == easy; });
+    if (it == active.end()) {
+        return;
+    }
+
+    auto transfer = std::move(*it);
+    active.erase(it);
+
+    HttpResponse response;
+    if (result != CURLE_OK) {
+        response.success = false;
+        response.error_message = curl_easy_strerror(result);
+        response.status_code = 0;
+    } else {
+        long response_code;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response_code);
+
+        response.body = std::move(transfer->response_body);
+        response.status_code = static_cast<int>(response_code);
+        response.headers = std::move(transfer->response_headers);
+        response.success = (response_code >= 200 && response_code < 300);
+        response.timing = HttpClient::captureTiming(easy);
+    }
+
+    curl_multi_remove_handle(multi_, easy);
+    curl_easy_cleanup(easy);
+    if (transfer->headers_list) {
+        curl_slist_free_all(transfer->headers_list);
+    }
+
+    if (transfer->on_complete) {
+        transfer->on_complete(std::move(response));
+    } else {
+        transfer->promise.set_value(std::move(response));
+    }
+}
+
+HttpTransferAwaitable::HttpTransferAwaitable(HttpRequest request, std::string metrics_label,
+                                             std::string model_label)
+    : request_(std::move(request)), metrics_label_(std::move(metrics_label)),
+      model_label_(std::move(model_label)) {
+}
+
+void HttpTransferAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    Telemetry::shared().emit(Telemetry::EventType::Enqueue, metrics_label_, model_label_);
+
+    // Pace through the provider's bucket before the transfer is submitted;
+    // acquire blocks the awaiting thread, not the engine. Retries are not
+    // attempted on this path — backing off would mean sleeping inside the
+    // completion callback on the shared event loop; callers that want
+    // retries use the synchronous HttpClient::send.
+    RateLimiter::shared().acquire(metrics_label_);
+    Telemetry::shared().emit(Telemetry::EventType::Send, metrics_label_, model_label_);
+    AsyncHttpClient::shared().submit(request_, [this, handle](HttpResponse response) {
+        RateLimiter::shared().observeResponse(metrics_label_, response);
+        MetricsRegistry::shared().record(metrics_label_, response.timing, response.success);
+        if (response.success) {
+            Telemetry::shared().emit(Telemetry::EventType::FirstByte, metrics_label_,
+                                     model_label_, response.timing.starttransfer_ms);
+            Telemetry::shared().emit(Telemetry::EventType::Complete, metrics_label_,
+                                     model_label_, response.timing.total_ms);
+        } else {
+            Telemetry::shared().emit(Telemetry::EventType::Error, metrics_label_,
+                                     model_label_, response.timing.total_ms);
+        }
+        response_ = std::move(response);
+        handle.resume();
+    });
+}
+
+HttpResponse HttpTransferAwaitable::await_resume() {
+    return std::move(response_);
+}
+
+void AsyncHttpClient::setupTransfer(Transfer& transfer) {
+    CURL* curl = transfer.easy;
+    const HttpRequest& request = transfer.request;
+
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+
+    if (request.method == "POST") {
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        if (request.upload) {
+            // Streamed body: curl pulls chunks through the read callback and
+            // the mapped source is never staged in a POSTFIELDS buffer.
+            request.upload->rewind();
+            curl_easy_setopt(curl, CURLOPT_READFUNCTION, HttpClient::uploadReadCallback);
+            curl_easy_setopt(curl, CURLOPT_READDATA, request.upload.get());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE,
+                             static_cast<curl_off_t>(request.upload->contentLength()));
+            curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, HttpClient::uploadSeekCallback);
+            curl_easy_setopt(curl, CURLOPT_SEEKDATA, request.upload.get());
+        } else {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
+        }
+    } else if (request.method == "PUT") {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
+    } else if (request.method == "DELETE") {
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+    }
+
+    struct curl_slist* headers_list = nullptr;
+    for (const auto& header : request.headers) {
+        std::string header_str = header.first + ": " + header.second;
+        headers_list = curl_slist_append(headers_list, header_str.c_str());
+    }
+
+    if (!request.headers.contains("User-Agent")) {
+        std::string ua_header = "User-Agent: " + request.user_agent;
+        headers_list = curl_slist_append(headers_list, ua_header.c_str());
+    }
+
+    if ((!request.body.empty() || request.upload) &&
+        !request.headers.contains("Content-Type")) {
+        headers_list = curl_slist_append(headers_list, "Content-Type: application/json");
+    }
+
+    if (headers_list) {
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers_list);
+    }
+    transfer.headers_list = headers_list;
+
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, transferWriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer.response_body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(request.timeout));
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 5L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, request.verify_ssl ? 1L : 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, request.verify_ssl ? 2L : 0L);
+
+    // Negotiate HTTP/2 over TLS and hold new transfers briefly so they can
+    // join an in-flight connection as another stream rather than opening
+    // their own (a 50-request burst then costs one handshake, not fifty).
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+
+    // Pool DNS entries and TLS sessions with every other handle in the
+    // process; the engine's own handles are short-lived and would otherwise
+    // resolve and handshake from scratch on every submission.
+    CurlShare::attach(curl);
+}
+
+size_t AsyncHttpClient::headerCallback(char* buffer, size_t size, size_t nitems, Transfer* transfer) {
+    size_t total_size = size * nitems;
+    std::string header(buffer, total_size);
+
+    size_t colon_pos = header.find(':');
+    if (colon_pos != std::string::npos) {
+        std::string name = header.substr(0, colon_pos);
+        std::string value = header.substr(colon_pos + 1);
+
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t\r\n") + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+        value.erase(value.find_last_not_of(" \t\r\n") + 1);
+
+        // Size the body buffer up front so the write callback appends
+        // without geometric reallocation on multi-MB bodies.
+        if (equalsIgnoreCase(name, "content-length")) {
+            unsigned long long length = std::strtoull(value.c_str(), nullptr, 10);
+            if (length > 0) {
+                transfer->response_body.reserve(
+                    std::min<size_t>(static_cast<size_t>(length), kMaxReserveBytes));
+            }
+        }
+
+        transfer->response_headers.set(std::move(name), std::move(value));
+    }
+
+    return total_size;
+}
+
+} // namespace api
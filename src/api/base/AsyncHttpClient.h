@@ -0,0 +1,99 @@
+#pragma once
+
+#include "HttpClient.h"
+#include <future>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <coroutine>
+#include <curl/curl.h>
+
+namespace api {
+
+// Asynchronous HTTP engine built on curl_multi. Callers submit any number of
+// HttpRequests; all transfers are multiplexed on a single event-loop thread
+// and each submission resolves through a std::future<HttpResponse>.
+//
+// Unlike HttpClient::send, completed responses never throw; HTTP error
+// statuses are reported through HttpResponse::success and status_code so a
+// failed transfer cannot tear down unrelated in-flight requests.
+class AsyncHttpClient {
+public:
+    AsyncHttpClient();
+    ~AsyncHttpClient();
+
+    AsyncHttpClient(const AsyncHttpClient&) = delete;
+    AsyncHttpClient& operator=(const AsyncHttpClient&) = delete;
+
+    // Invoked on the event-loop thread once a transfer finishes; keep the
+    // work short or hand it off so other transfers are not starved.
+    using CompletionCallback = std::function<void(HttpResponse response)>;
+
+    std::future<HttpResponse> submit(const HttpRequest& request);
+
+    // Callback form used by the coroutine layer: avoids parking a thread on
+    // future::get and resumes the awaiter directly from the event loop.
+    void submit(const HttpRequest& request, CompletionCallback on_complete);
+
+    // Caps concurrent connections held by the engine, mirroring
+    // ConnectionPoolConfig::max_connections.
+    void setMaxConnections(int max_connections);
+
+    // Per-host connection cap; with HTTP/2 multiplexing, bursts to one
+    // provider share this many connections as streams.
+    void setMaxHostConnections(int max_host_connections);
+
+    // Process-wide engine shared by all HttpClient instances.
+    static AsyncHttpClient& shared();
+
+private:
+    struct Transfer {
+        CURL* easy = nullptr;
+        struct curl_slist* headers_list = nullptr;
+        HttpRequest request;
+        std::string response_body;
+        HeaderMap response_headers;
+        std::promise<HttpResponse> promise;
+        CompletionCallback on_complete;
+    };
+
+    CURLM* multi_;
+    std::thread worker_;
+    std::mutex pending_mutex_;
+    std::vector<std::unique_ptr<Transfer>> pending_;
+    std::atomic<bool> running_;
+
+    void run();
+    void addPendingTransfers(std::vector<std::unique_ptr<Transfer>>& active);
+    void completeTransfer(std::vector<std::unique_ptr<Transfer>>& active, CURL* easy, CURLcode result);
+
+    std::unique_ptr<Transfer> makeTransfer(const HttpRequest& request);
+
+    static void setupTransfer(Transfer& transfer);
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, Transfer* transfer);
+};
+
+// Awaitable single HTTP transfer. co_awaiting one submits the request to the
+// shared engine and resumes the coroutine from the event-loop thread when the
+// response lands; like submit(), it reports HTTP errors through
+// HttpResponse::success rather than throwing.
+class HttpTransferAwaitable {
+public:
+    HttpTransferAwaitable(HttpRequest request, std::string metrics_label,
+                          std::string model_label);
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    HttpResponse await_resume();
+
+private:
+    HttpRequest request_;
+    std::string metrics_label_;
+    std::string model_label_;
+    HttpResponse response_;
+};
+
+} // namespace api
@@ -0,0 +1,32 @@
+#include "BufferPool.h"
+
+namespace api {
+
+std::string BufferPool::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.empty()) {
+        return {};
+    }
+    std::string buffer = std::move(idle_.back());
+    idle_.pop_back();
+    return buffer;
+}
+
+void BufferPool::release(std::string buffer) {
+    if (buffer.capacity() == 0 || buffer.capacity() > kMaxRetainedCapacity) {
+        return;
+    }
+    buffer.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() < kMaxPooled) {
+        idle_.push_back(std::move(buffer));
+    }
+}
+
+BufferPool& BufferPool::shared() {
+    static BufferPool pool;
+    return pool;
+}
+
+} // namespace api
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace api {
+
+// Recycles response-body buffers between requests. Buffers keep the
+// capacity grown by earlier responses, so a steady-state request appends
+// into memory that is already sized for a typical body instead of paying
+// geometric reallocations — allocator profiles put body growth at the top
+// malloc site under load.
+class BufferPool {
+public:
+    BufferPool() = default;
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // Returns an empty buffer, reusing a pooled one when available.
+    std::string acquire();
+
+    // Returns a spent buffer to the pool. Oversized or surplus buffers are
+    // dropped so the pool cannot hoard memory after a burst of huge bodies.
+    void release(std::string buffer);
+
+    // Process-wide pool shared by every transfer.
+    static BufferPool& shared();
+
+private:
+    // Keep at most this many buffers, each at most this large.
+    static constexpr size_t kMaxPooled = 16;
+    static constexpr size_t kMaxRetainedCapacity = 8 * 1024 * 1024;
+
+    std::mutex mutex_;
+    std::vector<std::string> idle_;
+};
+
+} // namespace api
@@ -0,0 +1,68 @@
+#include "Conversation.h"
+#include <nlohmann/json.hpp>
+
+namespace api {
+
+namespace {
+
+std::string serializeMessage(const ChatMessage& message) {
+    nlohmann::json json = {{"role", message.role}, {"content", message.content}};
+    return json.dump();
+}
+
+} // namespace
+
+void Conversation::addUserMessage(const std::string& content) {
+    ChatMessage message{"user", content};
+    appendToPrefix(message);
+    messages_.push_back(std::move(message));
+}
+
+void Conversation::addAssistantMessage(const std::string& content) {
+    ChatMessage message{"assistant", content};
+    appendToPrefix(message);
+    messages_.push_back(std::move(message));
+}
+
+const std::vector<ChatMessage>& Conversation::messages() const {
+    return messages_;
+}
+
+size_t Conversation::size() const {
+    return messages_.size();
+}
+
+void Conversation::clear() {
+    messages_.clear();
+    serialized_prefix_.clear();
+}
+
+MessageRequest Conversation::buildRequest(const std::string& next_user_message) const {
+    MessageRequest request;
+    request.message = next_user_message;
+    request.history = messages_;
+    request.serialized_messages = serializeMessages(next_user_message);
+    return request;
+}
+
+std::string Conversation::serializeMessages(const std::string& next_user_message) const {
+    std::string out;
+    out.reserve(serialized_prefix_.size() + next_user_message.size() + 64);
+    out += '[';
+    out += serialized_prefix_;
+    if (!serialized_prefix_.empty()) {
+        out += ',';
+    }
+    out += serializeMessage(ChatMessage{"user", next_user_message});
+    out += ']';
+    return out;
+}
+
+void Conversation::appendToPrefix(const ChatMessage& message) {
+    if (!serialized_prefix_.empty()) {
+        serialized_prefix_ += ',';
+    }
+    serialized_prefix_ += serializeMessage(message);
+}
+
+} // namespace api
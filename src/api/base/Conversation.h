@@ -0,0 +1,39 @@
+#pragma once
+
+#include "IApiClient.h"
+#include <string>
+#include <vector>
+
+namespace api {
+
+// Multi-turn conversation transcript. Each appended turn is serialized once
+// into a growing JSON prefix, so building the request for turn N costs one
+// message's serialization instead of re-serializing all N-1 prior turns —
+// measurable CPU at 100+ turn transcripts.
+class Conversation {
+public:
+    void addUserMessage(const std::string& content);
+    void addAssistantMessage(const std::string& content);
+
+    const std::vector<ChatMessage>& messages() const;
+    size_t size() const;
+    void clear();
+
+    // Builds the request for the next turn: structured history for every
+    // provider plus the cached serialized messages array for providers whose
+    // wire format matches it. The new message is not added to the transcript;
+    // call addUserMessage/addAssistantMessage once the exchange completes.
+    MessageRequest buildRequest(const std::string& next_user_message) const;
+
+    // Serialized role/content messages array for the transcript plus the new
+    // user message; only the new message is serialized on this call.
+    std::string serializeMessages(const std::string& next_user_message) const;
+
+private:
+    std::vector<ChatMessage> messages_;
+    std::string serialized_prefix_; // comma-joined serialized prior turns
+
+    void appendToPrefix(const ChatMessage& message);
+};
+
+} // namespace api
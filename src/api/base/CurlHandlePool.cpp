@@ -0,0 +1,106 @@
+#include "CurlHandlePool.h"
+#include "CurlShare.h"
+#include "ApiException.h"
+
+namespace api {
+
+CurlHandlePool::Lease::Lease(CurlHandlePool* pool, CURL* handle)
+    : pool_(pool), handle_(handle) {
+}
+
+CurlHandlePool::Lease::~Lease() {
+    if (pool_ && handle_) {
+        pool_->release(handle_);
+    }
+}
+
+CurlHandlePool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), handle_(other.handle_) {
+    other.pool_ = nullptr;
+    other.handle_ = nullptr;
+}
+
+CurlHandlePool::Lease& CurlHandlePool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (pool_ && handle_) {
+            pool_->release(handle_);
+        }
+        pool_ = other.pool_;
+        handle_ = other.handle_;
+        other.pool_ = nullptr;
+        other.handle_ = nullptr;
+    }
+    return *this;
+}
+
+CurlHandlePool::~CurlHandlePool() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (CURL* handle : idle_) {
+        curl_easy_cleanup(handle);
+    }
+    idle_.clear();
+}
+
+void CurlHandlePool::configure(const config::ConnectionPoolConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (config.max_connections > 0) {
+        max_connections_ = config.max_connections;
+    }
+    keep_alive_ = config.keep_alive;
+}
+
+CurlHandlePool::Lease CurlHandlePool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (idle_.empty() && total_handles_ >= max_connections_) {
+        available_.wait(lock);
+    }
+
+    if (!idle_.empty()) {
+        CURL* handle = idle_.back();
+        idle_.pop_back();
+        return Lease(this, handle);
+    }
+
+    CURL* handle = createHandle();
+    ++total_handles_;
+    return Lease(this, handle);
+}
+
+CurlHandlePool& CurlHandlePool::shared() {
+    static CurlHandlePool pool;
+    return pool;
+}
+
+void CurlHandlePool::release(CURL* handle) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (keep_alive_) {
+            // curl_easy_reset clears request state but keeps the handle's
+            // connection cache, so the next lease reuses warm connections
+            // instead of paying a fresh TCP/TLS handshake. The reset also
+            // drops CURLOPT_SHARE, so the shared cache is re-attached.
+            curl_easy_reset(handle);
+            CurlShare::attach(handle);
+            idle_.push_back(handle);
+        } else {
+            curl_easy_cleanup(handle);
+            --total_handles_;
+        }
+    }
+    available_.notify_one();
+}
+
+CURL* CurlHandlePool::createHandle() {
+    CURL* handle = curl_easy_init();
+    if (!handle) {
+        throw ConnectionException("Failed to initialize pooled CURL handle");
+    }
+    if (keep_alive_) {
+        curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    }
+    CurlShare::attach(handle);
+    return handle;
+}
+
+} // namespace api
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "../../config/ApiConfig.h"
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <curl/curl.h>
+
+namespace api {
+
+// Shared pool of warm curl easy handles, sized by
+// ConnectionPoolConfig::max_connections. Handles are created lazily, kept
+// alive between leases so curl can reuse their TCP/TLS connections, and
+// callers block when every handle is checked out.
+class CurlHandlePool {
+public:
+    // RAII lease; the handle returns to the pool when the lease is destroyed.
+    class Lease {
+    public:
+        Lease(CurlHandlePool* pool, CURL* handle);
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        CURL* get() const { return handle_; }
+
+    private:
+        CurlHandlePool* pool_;
+        CURL* handle_;
+    };
+
+    CurlHandlePool() = default;
+    ~CurlHandlePool();
+
+    CurlHandlePool(const CurlHandlePool&) = delete;
+    CurlHandlePool& operator=(const CurlHandlePool&) = delete;
+
+    // Applies connection_pool settings from the loaded configuration.
+    // Safe to call once at startup before handles are leased.
+    void configure(const config::ConnectionPoolConfig& config);
+
+    Lease acquire();
+
+    // Process-wide pool shared by all HttpClient instances.
+    static CurlHandlePool& shared();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<CURL*> idle_;
+    int total_handles_ = 0;
+    int max_connections_ = 10;
+    bool keep_alive_ = true;
+
+    void release(CURL* handle);
+    CURL* createHandle();
+};
+
+} // namespace api
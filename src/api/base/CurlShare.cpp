@@ -0,0 +1,48 @@
+#include "CurlShare.h"
+#include "ApiException.h"
+
+namespace api {
+
+CurlShare::CurlShare()
+    : share_(nullptr) {
+    share_ = curl_share_init();
+    if (!share_) {
+        throw ConnectionException("Failed to initialize CURL share handle");
+    }
+
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+
+    // The shared caches are touched from the pool's caller threads and the
+    // async engine's event loop concurrently, so curl needs real locks.
+    curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, lockCallback);
+    curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, unlockCallback);
+    curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+}
+
+CurlShare::~CurlShare() {
+    curl_share_cleanup(share_);
+}
+
+CurlShare& CurlShare::instance() {
+    static CurlShare share;
+    return share;
+}
+
+void CurlShare::attach(CURL* curl) {
+    curl_easy_setopt(curl, CURLOPT_SHARE, instance().share_);
+}
+
+void CurlShare::lockCallback(CURL* /*curl*/, curl_lock_data data,
+                             curl_lock_access /*access*/, void* user_ptr) {
+    auto* self = static_cast<CurlShare*>(user_ptr);
+    self->locks_[data].lock();
+}
+
+void CurlShare::unlockCallback(CURL* /*curl*/, curl_lock_data data, void* user_ptr) {
+    auto* self = static_cast<CurlShare*>(user_ptr);
+    self->locks_[data].unlock();
+}
+
+} // namespace api
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mutex>
+#include <curl/curl.h>
+
+namespace api {
+
+// Process-wide curl share handle pooling DNS entries, TLS session tickets
+// and the connection cache across every easy handle in the process, whether
+// it comes from CurlHandlePool or the async engine. Without it each client's
+// handles resolve and handshake independently; behind a slow resolver that
+// costs 50-150ms per fresh client.
+class CurlShare {
+public:
+    CurlShare(const CurlShare&) = delete;
+    CurlShare& operator=(const CurlShare&) = delete;
+
+    // Attaches the shared cache to an easy handle. Must be re-applied after
+    // curl_easy_reset, which clears CURLOPT_SHARE.
+    static void attach(CURL* curl);
+
+private:
+    CurlShare();
+    ~CurlShare();
+
+    static CurlShare& instance();
+
+    static void lockCallback(CURL* curl, curl_lock_data data,
+                             curl_lock_access access, void* user_ptr);
+    static void unlockCallback(CURL* curl, curl_lock_data data, void* user_ptr);
+
+    CURLSH* share_;
+    std::mutex locks_[CURL_LOCK_DATA_LAST];
+};
+
+} // namespace api
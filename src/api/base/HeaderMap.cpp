@@ -0,0 +1,84 @@
+#include "HeaderMap.h"
+#include <algorithm>
+#include <cctype>
+
+namespace api {
+
+namespace {
+
+// Case-insensitive ordering on header names.
+bool lessIgnoreCase(std::string_view a, std::string_view b) {
+    return std::lexicographical_compare(
+        a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) <
+                   std::tolower(static_cast<unsigned char>(y));
+        });
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return !lessIgnoreCase(a, b) && !lessIgnoreCase(b, a);
+}
+
+} // namespace
+
+HeaderMap::HeaderMap(std::initializer_list<value_type> init) {
+    entries_.reserve(init.size());
+    for (auto& entry : init) {
+        set(entry.first, entry.second);
+    }
+}
+
+void HeaderMap::set(std::string name, std::string value) {
+    auto it = std::lower_bound(
+        entries_.begin(), entries_.end(), name,
+        [](const value_type& entry, const std::string& key) {
+            return lessIgnoreCase(entry.first, key);
+        });
+    if (it != entries_.end() && equalsIgnoreCase(it->first, name)) {
+        it->second = std::move(value);
+        return;
+    }
+    entries_.emplace(it, std::move(name), std::move(value));
+}
+
+const std::string* HeaderMap::find(std::string_view name) const {
+    auto it = std::lower_bound(
+        entries_.begin(), entries_.end(), name,
+        [](const value_type& entry, std::string_view key) {
+            return lessIgnoreCase(entry.first, key);
+        });
+    if (it != entries_.end() && equalsIgnoreCase(it->first, name)) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+bool HeaderMap::contains(std::string_view name) const {
+    return find(name) != nullptr;
+}
+
+void HeaderMap::reserve(size_t count) {
+    entries_.reserve(count);
+}
+
+void HeaderMap::clear() {
+    entries_.clear();
+}
+
+bool HeaderMap::empty() const {
+    return entries_.empty();
+}
+
+size_t HeaderMap::size() const {
+    return entries_.size();
+}
+
+HeaderMap::const_iterator HeaderMap::begin() const {
+    return entries_.begin();
+}
+
+HeaderMap::const_iterator HeaderMap::end() const {
+    return entries_.end();
+}
+
+} // namespace api
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace api {
+
+// Flat HTTP header container: a vector of name/value pairs kept sorted by
+// case-insensitive name, looked up by binary search. A request carries a
+// dozen-odd headers, where contiguous storage beats the node allocations
+// and pointer chasing of a std::map on every request we send. Names are
+// matched case-insensitively per RFC 9110.
+class HeaderMap {
+public:
+    using value_type = std::pair<std::string, std::string>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    HeaderMap() = default;
+    HeaderMap(std::initializer_list<value_type> init);
+
+    // Inserts the header, replacing any existing value under the same name.
+    void set(std::string name, std::string value);
+
+    // Returns the value for the name, or nullptr when absent.
+    const std::string* find(std::string_view name) const;
+
+    bool contains(std::string_view name) const;
+
+    void reserve(size_t count);
+    void clear();
+    bool empty() const;
+    size_t size() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    std::vector<value_type> entries_;
+};
+
+} // namespace api
@@ -1,36 +1,148 @@
 #include "HttpClient.h"
+#include "AsyncHttpClient.h"
+#include "CurlHandlePool.h"
+#include "RateLimiter.h"
+#include "Telemetry.h"
 #include "ApiException.h"
+#include <chrono>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 namespace api {
 
 HttpClient::HttpClient()
-    : curl_(nullptr), default_timeout_(30000), user_agent_("AI-CLI/1.0"), verify_ssl_(true) {
-    curl_ = curl_easy_init();
-    if (!curl_) {
-        throw ConnectionException("Failed to initialize CURL");
-    }
+    : default_timeout_(30000), user_agent_("AI-CLI/1.0"), verify_ssl_(true),
+      metrics_label_("http"), retry_policy_(RetryPolicy::defaults()) {
 }
 
-HttpClient::~HttpClient() {
-    if (curl_) {
-        curl_easy_cleanup(curl_);
-    }
-}
+HttpClient::~HttpClient() = default;
 
 HttpResponse HttpClient::send(const HttpRequest& request) {
-    if (!curl_) {
-        throw ConnectionException("CURL not initialized");
+    // Synchronous sends are one-transfer submissions to the shared
+    // curl_multi engine; concurrent callers share its event loop instead of
+    // serializing on a per-client easy handle.
+    HttpRequest prepared = request;
+    if (prepared.timeout <= 0) {
+        prepared.timeout = default_timeout_;
     }
+    prepared.user_agent = user_agent_;
+    prepared.verify_ssl = verify_ssl_;
+
+    Telemetry::shared().emit(Telemetry::EventType::Enqueue, metrics_label_, model_label_);
 
-    std::string response_body;
-    std::map<std::string, std::string> response_headers;
     HttpResponse response;
+    for (int attempt = 1; ; ++attempt) {
+        // Pace outbound requests at the provider's configured ceiling and
+        // feed rate-limit feedback from each response back into the bucket.
+        RateLimiter::shared().acquire(metrics_label_);
+        Telemetry::shared().emit(Telemetry::EventType::Send, metrics_label_, model_label_);
+        response = AsyncHttpClient::shared().submit(prepared).get();
+        RateLimiter::shared().observeResponse(metrics_label_, response);
+        MetricsRegistry::shared().record(metrics_label_, response.timing, response.success);
+        if (response.success) {
+            Telemetry::shared().emit(Telemetry::EventType::FirstByte, metrics_label_,
+                                     model_label_, response.timing.starttransfer_ms);
+            Telemetry::shared().emit(Telemetry::EventType::Complete, metrics_label_,
+                                     model_label_, response.timing.total_ms);
+        } else {
+            Telemetry::shared().emit(Telemetry::EventType::Error, metrics_label_,
+                                     model_label_, response.timing.total_ms);
+        }
 
-    setupRequest(curl_, request, response_body, response_headers);
+        // Transient failures (429, 5xx, transport errors) are retried with
+        // jittered exponential backoff before any exception is raised.
+        if (!RetryPolicy::shouldRetry(response) || attempt >= retry_policy_.max_attempts) {
+            break;
+        }
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(retry_policy_.delayForAttempt(attempt)));
+    }
+    return checkResponse(std::move(response));
+}
 
-    CURLcode res = curl_easy_perform(curl_);
+HttpResponse HttpClient::sendStream(const HttpRequest& request, const DataCallback& on_data) {
+    auto lease = CurlHandlePool::shared().acquire();
+    CURL* curl = lease.get();
+
+    std::string response_body;
+    HeaderMap response_headers;
+
+    struct curl_slist* headers_list = setupRequest(curl, request, response_body, response_headers);
+
+    // Replace the accumulating write callback with one that also forwards
+    // each chunk to the caller as it arrives.
+    StreamContext context{&response_body, &on_data};
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeStreamCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &context);
+
+    Telemetry::shared().emit(Telemetry::EventType::Enqueue, metrics_label_, model_label_);
+
+    // Streams pace through the same bucket as plain sends. They are not
+    // retried here though: chunks already handed to the caller cannot be
+    // replayed, so a mid-stream failure surfaces as the error it is.
+    RateLimiter::shared().acquire(metrics_label_);
+    Telemetry::shared().emit(Telemetry::EventType::Send, metrics_label_, model_label_);
+    CURLcode res = curl_easy_perform(curl);
+
+    auto timing = captureTiming(curl);
+    if (res == CURLE_OK) {
+        Telemetry::shared().emit(Telemetry::EventType::FirstByte, metrics_label_,
+                                 model_label_, timing.starttransfer_ms);
+        Telemetry::shared().emit(Telemetry::EventType::Complete, metrics_label_,
+                                 model_label_, timing.total_ms);
+    } else {
+        Telemetry::shared().emit(Telemetry::EventType::Error, metrics_label_,
+                                 model_label_, timing.total_ms);
+    }
+
+    if (headers_list) {
+        curl_slist_free_all(headers_list);
+    }
+
+    auto response = finishRequest(res, curl, response_body, response_headers);
+    RateLimiter::shared().observeResponse(metrics_label_, response);
+    return response;
+}
+
+void HttpClient::setMetricsLabel(const std::string& label) {
+    metrics_label_ = label;
+}
+
+void HttpClient::setModelLabel(const std::string& label) {
+    model_label_ = label;
+}
+
+void HttpClient::setRetryPolicy(const RetryPolicy& policy) {
+    retry_policy_ = policy;
+}
+
+TransferTiming HttpClient::captureTiming(CURL* curl) {
+    TransferTiming timing;
+    double seconds = 0.0;
+
+    if (curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &seconds) == CURLE_OK) {
+        timing.namelookup_ms = seconds * 1000.0;
+    }
+    if (curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &seconds) == CURLE_OK) {
+        timing.connect_ms = seconds * 1000.0;
+    }
+    if (curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &seconds) == CURLE_OK) {
+        timing.appconnect_ms = seconds * 1000.0;
+    }
+    if (curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &seconds) == CURLE_OK) {
+        timing.starttransfer_ms = seconds * 1000.0;
+    }
+    if (curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &seconds) == CURLE_OK) {
+        timing.total_ms = seconds * 1000.0;
+    }
+
+    return timing;
+}
+
+HttpResponse HttpClient::finishRequest(CURLcode res, CURL* curl, const std::string& response_body,
+                                     const HeaderMap& response_headers) {
+    HttpResponse response;
 
     if (res != CURLE_OK) {
         response.success = false;
@@ -40,22 +152,29 @@ HttpResponse HttpClient::send(const HttpRequest& request) {
     }
 
     long response_code;
-    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
 
     response.body = response_body;
     response.status_code = static_cast<int>(response_code);
     response.headers = response_headers;
     response.success = (response_code >= 200 && response_code < 300);
+    response.timing = captureTiming(curl);
 
-    if (!response.success) {
-        if (response_code == 401) {
-            throw AuthenticationException("Authentication failed: " + response_body);
-        } else if (response_code == 429) {
-            throw RateLimitException("Rate limit exceeded: " + response_body);
-        } else if (response_code >= 400 && response_code < 500) {
-            throw InvalidRequestException("Client error: " + response_body);
-        } else if (response_code >= 500) {
-            throw ConnectionException("Server error: " + response_body, response_code);
+    MetricsRegistry::shared().record(metrics_label_, response.timing, response.success);
+
+    return checkResponse(std::move(response));
+}
+
+HttpResponse HttpClient::checkResponse(HttpResponse response) {
+    if (!response.success && response.status_code > 0) {
+        if (response.status_code == 401) {
+            throw AuthenticationException("Authentication failed: " + response.body);
+        } else if (response.status_code == 429) {
+            throw RateLimitException("Rate limit exceeded: " + response.body);
+        } else if (response.status_code >= 400 && response.status_code < 500) {
+            throw InvalidRequestException("Client error: " + response.body);
+        } else if (response.status_code >= 500) {
+            throw ConnectionException("Server error: " + response.body, response.status_code);
         }
     }
 
@@ -63,7 +182,7 @@ HttpResponse HttpClient::send(const HttpRequest& request) {
 }
 
 HttpResponse HttpClient::get(const std::string& url,
-                           const std::map<std::string, std::string>& headers) {
+                           const HeaderMap& headers) {
     HttpRequest request;
     request.url = url;
     request.method = "GET";
@@ -74,7 +193,7 @@ HttpResponse HttpClient::get(const std::string& url,
 
 HttpResponse HttpClient::post(const std::string& url,
                             const std::string& body,
-                            const std::map<std::string, std::string>& headers) {
+                            const HeaderMap& headers) {
     HttpRequest request;
     request.url = url;
     request.method = "POST";
@@ -84,9 +203,48 @@ HttpResponse HttpClient::post(const std::string& url,
     return send(request);
 }
 
+HttpResponse HttpClient::post(const std::string& url,
+                            std::shared_ptr<UploadBody> upload,
+                            const HeaderMap& headers) {
+    HttpRequest request;
+    request.url = url;
+    request.method = "POST";
+    request.upload = std::move(upload);
+    request.headers = headers;
+    request.timeout = default_timeout_;
+    return send(request);
+}
+
+HttpTransferAwaitable HttpClient::coPost(const std::string& url,
+                                         const std::string& body,
+                                         const HeaderMap& headers) {
+    HttpRequest request;
+    request.url = url;
+    request.method = "POST";
+    request.body = body;
+    request.headers = headers;
+    request.timeout = default_timeout_;
+    request.user_agent = user_agent_;
+    request.verify_ssl = verify_ssl_;
+    return HttpTransferAwaitable(std::move(request), metrics_label_, model_label_);
+}
+
+HttpResponse HttpClient::postStream(const std::string& url,
+                                  const std::string& body,
+                                  const HeaderMap& headers,
+                                  const DataCallback& on_data) {
+    HttpRequest request;
+    request.url = url;
+    request.method = "POST";
+    request.body = body;
+    request.headers = headers;
+    request.timeout = default_timeout_;
+    return sendStream(request, on_data);
+}
+
 HttpResponse HttpClient::put(const std::string& url,
                            const std::string& body,
-                           const std::map<std::string, std::string>& headers) {
+                           const HeaderMap& headers) {
     HttpRequest request;
     request.url = url;
     request.method = "PUT";
@@ -97,7 +255,7 @@ HttpResponse HttpClient::put(const std::string& url,
 }
 
 HttpResponse HttpClient::delete_(const std::string& url,
-                               const std::map<std::string, std::string>& headers) {
+                               const HeaderMap& headers) {
     HttpRequest request;
     request.url = url;
     request.method = "DELETE";
@@ -124,8 +282,17 @@ size_t HttpClient::writeCallback(void* contents, size_t size, size_t nmemb, std:
     return total_size;
 }
 
+size_t HttpClient::writeStreamCallback(void* contents, size_t size, size_t nmemb, StreamContext* context) {
+    size_t total_size = size * nmemb;
+    context->body->append(static_cast<char*>(contents), total_size);
+    if (*context->on_data) {
+        (*context->on_data)(static_cast<char*>(contents), total_size);
+    }
+    return total_size;
+}
+
 size_t HttpClient::headerCallback(char* buffer, size_t size, size_t nitems,
-                                std::map<std::string, std::string>* headers) {
+                                HeaderMap* headers) {
     size_t total_size = size * nitems;
     std::string header(buffer, total_size);
 
@@ -140,14 +307,29 @@ size_t HttpClient::headerCallback(char* buffer, size_t size, size_t nitems,
         value.erase(0, value.find_first_not_of(" \t"));
         value.erase(value.find_last_not_of(" \t\r\n") + 1);
 
-        (*headers)[name] = value;
+        headers->set(std::move(name), std::move(value));
     }
 
     return total_size;
 }
 
-void HttpClient::setupRequest(CURL* curl, const HttpRequest& request, std::string& response_body,
-                            std::map<std::string, std::string>& response_headers) {
+size_t HttpClient::uploadReadCallback(char* buffer, size_t size, size_t nitems,
+                                      UploadBody* upload) {
+    return upload->read(buffer, size * nitems);
+}
+
+int HttpClient::uploadSeekCallback(UploadBody* upload, curl_off_t offset, int origin) {
+    // Retries and redirects rewind to the start; the body is a forward
+    // stream, so arbitrary offsets are not supported.
+    if (origin == SEEK_SET && offset == 0) {
+        upload->rewind();
+        return CURL_SEEKFUNC_OK;
+    }
+    return CURL_SEEKFUNC_CANTSEEK;
+}
+
+struct curl_slist* HttpClient::setupRequest(CURL* curl, const HttpRequest& request, std::string& response_body,
+                                          HeaderMap& response_headers) {
     // Reset curl handle
     curl_easy_reset(curl);
 
@@ -157,8 +339,20 @@ void HttpClient::setupRequest(CURL* curl, const HttpRequest& request, std::strin
     // Set method
     if (request.method == "POST") {
         curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
+        if (request.upload) {
+            // The body streams through the read callback; nothing is staged
+            // in a POSTFIELDS buffer.
+            request.upload->rewind();
+            curl_easy_setopt(curl, CURLOPT_READFUNCTION, uploadReadCallback);
+            curl_easy_setopt(curl, CURLOPT_READDATA, request.upload.get());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE,
+                             static_cast<curl_off_t>(request.upload->contentLength()));
+            curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, uploadSeekCallback);
+            curl_easy_setopt(curl, CURLOPT_SEEKDATA, request.upload.get());
+        } else {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.body.length());
+        }
     } else if (request.method == "PUT") {
         curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
         curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body.c_str());
@@ -175,12 +369,13 @@ void HttpClient::setupRequest(CURL* curl, const HttpRequest& request, std::strin
     }
 
     // Add default headers
-    if (request.headers.find("User-Agent") == request.headers.end()) {
+    if (!request.headers.contains("User-Agent")) {
         std::string ua_header = "User-Agent: " + user_agent_;
         headers_list = curl_slist_append(headers_list, ua_header.c_str());
     }
 
-    if (!request.body.empty() && request.headers.find("Content-Type") == request.headers.end()) {
+    if ((!request.body.empty() || request.upload) &&
+        !request.headers.contains("Content-Type")) {
         headers_list = curl_slist_append(headers_list, "Content-Type: application/json");
     }
 
@@ -201,10 +396,13 @@ void HttpClient::setupRequest(CURL* curl, const HttpRequest& request, std::strin
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, verify_ssl_ ? 1L : 0L);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, verify_ssl_ ? 2L : 0L);
 
-    // Clean up headers list when done
-    if (headers_list) {
-        curl_slist_free_all(headers_list);
-    }
+    // Prefer HTTP/2 over TLS so pooled handles reuse one multiplexed
+    // connection per provider instead of a connection per request.
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+
+    // Ownership passes to the caller, which must keep the list alive until
+    // the transfer completes and free it afterwards.
+    return headers_list;
 }
 
 } // namespace api
\ No newline at end of file
@@ -1,26 +1,39 @@
 #pragma once
 
+#include "HeaderMap.h"
+#include "Metrics.h"
+#include "UploadBody.h"
+#include "RetryPolicy.h"
 #include <string>
 #include <map>
 #include <memory>
+#include <functional>
 #include <curl/curl.h>
 
 namespace api {
 
+class HttpTransferAwaitable;
+
 struct HttpRequest {
     std::string url;
     std::string method = "GET";
     std::string body;
-    std::map<std::string, std::string> headers;
+    // When set, the body streams through curl's read callback from this
+    // source instead of `body`; see UploadBody.
+    std::shared_ptr<UploadBody> upload;
+    HeaderMap headers;
     int timeout = 30000; // milliseconds
+    std::string user_agent = "AI-CLI/1.0";
+    bool verify_ssl = true;
 };
 
 struct HttpResponse {
     std::string body;
     int status_code;
-    std::map<std::string, std::string> headers;
+    HeaderMap headers;
     bool success;
     std::string error_message;
+    TransferTiming timing;
 };
 
 class HttpClient {
@@ -31,21 +44,44 @@ public:
     HttpClient(const HttpClient&) = delete;
     HttpClient& operator=(const HttpClient&) = delete;
 
+    // Invoked from curl's write callback with each raw body chunk as it
+    // arrives, before the transfer completes.
+    using DataCallback = std::function<void(const char* data, size_t length)>;
+
     HttpResponse send(const HttpRequest& request);
 
+    HttpResponse sendStream(const HttpRequest& request, const DataCallback& on_data);
+
     HttpResponse get(const std::string& url,
-                    const std::map<std::string, std::string>& headers = {});
+                    const HeaderMap& headers = {});
 
     HttpResponse post(const std::string& url,
                      const std::string& body,
-                     const std::map<std::string, std::string>& headers = {});
+                     const HeaderMap& headers = {});
+
+    // Streamed-body POST: the payload is fed to curl incrementally from
+    // `upload` rather than held as one contiguous string.
+    HttpResponse post(const std::string& url,
+                     std::shared_ptr<UploadBody> upload,
+                     const HeaderMap& headers = {});
+
+    // Awaitable POST for coroutine callers; resolves with the raw response
+    // (no exception mapping) on the shared engine's event-loop thread.
+    HttpTransferAwaitable coPost(const std::string& url,
+                                 const std::string& body,
+                                 const HeaderMap& headers = {});
+
+    HttpResponse postStream(const std::string& url,
+                           const std::string& body,
+                           const HeaderMap& headers,
+                           const DataCallback& on_data);
 
     HttpResponse put(const std::string& url,
                     const std::string& body,
-                    const std::map<std::string, std::string>& headers = {});
+                    const HeaderMap& headers = {});
 
     HttpResponse delete_(const std::string& url,
-                        const std::map<std::string, std::string>& headers = {});
+                        const HeaderMap& headers = {});
 
     void setDefaultTimeout(int timeout_ms);
 
@@ -53,17 +89,50 @@ public:
 
     void setVerifySSL(bool verify);
 
+    // Provider label under which this client's transfers are recorded in
+    // the shared MetricsRegistry.
+    void setMetricsLabel(const std::string& label);
+
+    // Model label attached to lifecycle events in the shared Telemetry ring;
+    // clients update it per request when the model is overridden.
+    void setModelLabel(const std::string& label);
+
+    // Overrides the process-wide retry defaults for this client.
+    void setRetryPolicy(const RetryPolicy& policy);
+
+    // Reads curl's per-phase timers off a completed transfer.
+    static TransferTiming captureTiming(CURL* curl);
+
+    // curl read/seek adapters for streamed upload bodies; shared with the
+    // async engine's transfer setup.
+    static size_t uploadReadCallback(char* buffer, size_t size, size_t nitems,
+                                     UploadBody* upload);
+    static int uploadSeekCallback(UploadBody* upload, curl_off_t offset, int origin);
+
 private:
-    CURL* curl_;
     int default_timeout_;
     std::string user_agent_;
     bool verify_ssl_;
+    std::string metrics_label_;
+    std::string model_label_;
+    RetryPolicy retry_policy_;
+
+    struct StreamContext {
+        std::string* body;
+        const DataCallback* on_data;
+    };
 
     static size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* response);
-    static size_t headerCallback(char* buffer, size_t size, size_t nitems, std::map<std::string, std::string>* headers);
+    static size_t writeStreamCallback(void* contents, size_t size, size_t nmemb, StreamContext* context);
+    static size_t headerCallback(char* buffer, size_t size, size_t nitems, HeaderMap* headers);
+
+    struct curl_slist* setupRequest(CURL* curl, const HttpRequest& request, std::string& response_body,
+                                   HeaderMap& response_headers);
+
+    HttpResponse finishRequest(CURLcode res, CURL* curl, const std::string& response_body,
+                              const HeaderMap& response_headers);
 
-    void setupRequest(CURL* curl, const HttpRequest& request, std::string& response_body,
-                     std::map<std::string, std::string>& response_headers);
+    static HttpResponse checkResponse(HttpResponse response);
 };
 
 } // namespace api
\ No newline at end of file
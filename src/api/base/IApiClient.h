@@ -1,34 +1,78 @@
 #pragma once
 
+#include "HeaderMap.h"
+#include "Task.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <functional>
 
 namespace api {
 
 struct ApiResponse {
     std::string content;
     int status_code;
-    std::map<std::string, std::string> headers;
+    HeaderMap headers;
     bool success;
     std::string error_message;
 };
 
+// One prior turn of a conversation; role is "user" or "assistant" and is
+// mapped to each provider's own role vocabulary when the payload is built.
+struct ChatMessage {
+    std::string role;
+    std::string content;
+};
+
 struct MessageRequest {
     std::string message;
     std::string model;
     int max_tokens;
     double temperature;
     std::vector<std::string> stop_sequences;
+
+    // Prior turns preceding `message`, oldest first. Empty for single-turn.
+    std::vector<ChatMessage> history;
+
+    // Optional pre-serialized role/content messages array covering history
+    // plus `message`, produced by Conversation's incremental cache. Clients
+    // whose wire format matches (Anthropic, OpenAI) splice it in verbatim
+    // instead of re-serializing the transcript.
+    std::string serialized_messages;
+
+    // Optional path to a document appended to `message` as context. On the
+    // synchronous send path the file is memory-mapped and streamed into the
+    // transfer with JSON escaping applied on the fly, so a multi-megabyte
+    // context is never duplicated on the heap.
+    std::string context_file;
 };
 
+// Invoked once per streamed content delta as it arrives off the wire.
+using StreamCallback = std::function<void(const std::string& chunk)>;
+
+// A client instance serves one request at a time: implementations keep
+// per-request state (payload templates, the transport's model label) in the
+// instance, so concurrent callers must each own a client rather than share
+// one. The heavyweight machinery — connection pool, caches, rate limiter —
+// is process-wide and shared by all instances regardless.
 class IApiClient {
 public:
     virtual ~IApiClient() = default;
 
     virtual ApiResponse sendMessage(const MessageRequest& request) = 0;
 
+    virtual ApiResponse sendMessageStream(const MessageRequest& request,
+                                          const StreamCallback& on_chunk) = 0;
+
+    // Coroutine form of sendMessage. The task suspends while the transfer is
+    // in flight and resumes on the shared engine's event-loop thread, so any
+    // number of concurrent sends cost no blocked threads. Unlike sendMessage,
+    // HTTP errors surface through ApiResponse rather than exceptions. The
+    // request is taken by value: the coroutine frame must own it across
+    // suspension points.
+    virtual Task<ApiResponse> co_sendMessage(MessageRequest request) = 0;
+
     virtual std::vector<std::string> getAvailableModels() = 0;
 
     virtual void setModel(const std::string& model) = 0;
@@ -46,6 +90,8 @@ public:
     virtual void testConnection() = 0;
 
     virtual std::map<std::string, std::string> getConnectionInfo() const = 0;
+
+    virtual std::map<std::string, std::string> getMetrics() const = 0;
 };
 
 using ApiClientPtr = std::unique_ptr<IApiClient>;
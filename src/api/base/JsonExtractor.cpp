@@ -0,0 +1,137 @@
+#include "JsonExtractor.h"
+#include <nlohmann/json.hpp>
+
+namespace api {
+
+namespace {
+
+// SAX consumer that tracks the current position in the document and captures
+// the first string value whose position matches the requested path.
+class StringFieldSax : public nlohmann::json::json_sax_t {
+public:
+    StringFieldSax(const std::vector<JsonPathToken>& path, JsonExtractResult& result)
+        : path_(path), result_(result) {
+    }
+
+    bool null() override {
+        valueCompleted();
+        return true;
+    }
+
+    bool boolean(bool) override {
+        valueCompleted();
+        return true;
+    }
+
+    bool number_integer(number_integer_t) override {
+        valueCompleted();
+        return true;
+    }
+
+    bool number_unsigned(number_unsigned_t) override {
+        valueCompleted();
+        return true;
+    }
+
+    bool number_float(number_float_t, const string_t&) override {
+        valueCompleted();
+        return true;
+    }
+
+    bool string(string_t& val) override {
+        if (matchesPath()) {
+            result_.value = val;
+            result_.found = true;
+            // Abort the parse; everything past the target is irrelevant.
+            return false;
+        }
+        valueCompleted();
+        return true;
+    }
+
+    bool binary(binary_t&) override {
+        valueCompleted();
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        stack_.push_back(Frame{false, "", 0});
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        stack_.back().key = val;
+        return true;
+    }
+
+    bool end_object() override {
+        stack_.pop_back();
+        valueCompleted();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        stack_.push_back(Frame{true, "", 0});
+        return true;
+    }
+
+    bool end_array() override {
+        stack_.pop_back();
+        valueCompleted();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception&) override {
+        result_.parse_error = true;
+        return false;
+    }
+
+private:
+    struct Frame {
+        bool is_array;
+        std::string key;  // current key when an object
+        int index;        // current element when an array
+    };
+
+    const std::vector<JsonPathToken>& path_;
+    JsonExtractResult& result_;
+    std::vector<Frame> stack_;
+
+    bool matchesPath() const {
+        if (stack_.size() != path_.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < path_.size(); ++i) {
+            const auto& token = path_[i];
+            const auto& frame = stack_[i];
+            if (token.is_index) {
+                if (!frame.is_array || frame.index != token.index) {
+                    return false;
+                }
+            } else {
+                if (frame.is_array || frame.key != token.key) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void valueCompleted() {
+        if (!stack_.empty() && stack_.back().is_array) {
+            ++stack_.back().index;
+        }
+    }
+};
+
+} // namespace
+
+JsonExtractResult extractJsonStringField(const std::string& body,
+                                         const std::vector<JsonPathToken>& path) {
+    JsonExtractResult result;
+    StringFieldSax sax(path, result);
+    nlohmann::json::sax_parse(body, &sax);
+    return result;
+}
+
+} // namespace api
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace api {
+
+// One step of a JSON path: either an object key or an array index.
+struct JsonPathToken {
+    JsonPathToken(const std::string& k) : is_index(false), key(k), index(0) {}
+    JsonPathToken(const char* k) : is_index(false), key(k), index(0) {}
+    JsonPathToken(int i) : is_index(true), index(i) {}
+
+    bool is_index;
+    std::string key;
+    int index;
+};
+
+struct JsonExtractResult {
+    bool found = false;
+    bool parse_error = false;
+    std::string value;
+};
+
+// Pulls a single string field out of a JSON document using nlohmann's SAX
+// interface, so multi-megabyte response bodies are scanned without
+// materializing a DOM. Parsing stops as soon as the target is found.
+JsonExtractResult extractJsonStringField(const std::string& body,
+                                         const std::vector<JsonPathToken>& path);
+
+} // namespace api
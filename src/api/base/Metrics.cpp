@@ -0,0 +1,133 @@
+#include "Metrics.h"
+#include <sstream>
+#include <iomanip>
+
+namespace api {
+
+namespace {
+
+size_t bucketFor(double total_ms) {
+    size_t bucket = 0;
+    double upper = 1.0;
+    while (bucket + 1 < MetricsRegistry::kHistogramBuckets && total_ms >= upper) {
+        upper *= 2.0;
+        ++bucket;
+    }
+    return bucket;
+}
+
+} // namespace
+
+void MetricsRegistry::record(const std::string& provider, const TransferTiming& timing, bool success) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& stats = stats_[provider];
+
+    if (stats.requests == 0 || timing.total_ms < stats.min_total_ms) {
+        stats.min_total_ms = timing.total_ms;
+    }
+    if (timing.total_ms > stats.max_total_ms) {
+        stats.max_total_ms = timing.total_ms;
+    }
+
+    ++stats.requests;
+    if (!success) {
+        ++stats.failures;
+    }
+
+    stats.sum.namelookup_ms += timing.namelookup_ms;
+    stats.sum.connect_ms += timing.connect_ms;
+    stats.sum.appconnect_ms += timing.appconnect_ms;
+    stats.sum.starttransfer_ms += timing.starttransfer_ms;
+    stats.sum.total_ms += timing.total_ms;
+
+    ++stats.histogram[bucketFor(timing.total_ms)];
+}
+
+std::map<std::string, MetricsRegistry::ProviderStats> MetricsRegistry::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::map<std::string, std::string> MetricsRegistry::providerMetrics(const std::string& provider) const {
+    std::map<std::string, std::string> metrics;
+
+    auto stats = snapshot();
+    auto it = stats.find(provider);
+    if (it == stats.end() || it->second.requests == 0) {
+        // emplace rather than operator[]= : GCC 12 at -O3 inlines the
+        // assignment into a self-overlapping memcpy and fails -Werror=restrict.
+        metrics.emplace("requests", "0");
+        return metrics;
+    }
+
+    const auto& s = it->second;
+    double count = static_cast<double>(s.requests);
+
+    auto format_ms = [](double value) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << value;
+        return out.str();
+    };
+
+    metrics["requests"] = std::to_string(s.requests);
+    metrics["failures"] = std::to_string(s.failures);
+    metrics["avg_dns_ms"] = format_ms(s.sum.namelookup_ms / count);
+    metrics["avg_connect_ms"] = format_ms(s.sum.connect_ms / count);
+    metrics["avg_tls_ms"] = format_ms(s.sum.appconnect_ms / count);
+    metrics["avg_ttfb_ms"] = format_ms(s.sum.starttransfer_ms / count);
+    metrics["avg_total_ms"] = format_ms(s.sum.total_ms / count);
+    metrics["min_total_ms"] = format_ms(s.min_total_ms);
+    metrics["max_total_ms"] = format_ms(s.max_total_ms);
+
+    return metrics;
+}
+
+std::string MetricsRegistry::report() const {
+    auto stats = snapshot();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    if (stats.empty()) {
+        out << "No requests recorded.\n";
+        return out.str();
+    }
+
+    for (const auto& pair : stats) {
+        const auto& s = pair.second;
+        double count = static_cast<double>(s.requests);
+
+        out << pair.first << ":\n";
+        out << "  requests: " << s.requests << " (" << s.failures << " failed)\n";
+        out << "  avg dns: " << s.sum.namelookup_ms / count << " ms"
+            << ", connect: " << s.sum.connect_ms / count << " ms"
+            << ", tls: " << s.sum.appconnect_ms / count << " ms"
+            << ", ttfb: " << s.sum.starttransfer_ms / count << " ms"
+            << ", total: " << s.sum.total_ms / count << " ms\n";
+        out << "  total min/max: " << s.min_total_ms << " / " << s.max_total_ms << " ms\n";
+
+        out << "  histogram (ms):";
+        double upper = 1.0;
+        for (size_t i = 0; i < kHistogramBuckets; ++i) {
+            if (s.histogram[i] > 0) {
+                if (i + 1 < kHistogramBuckets) {
+                    out << " <" << upper << ":" << s.histogram[i];
+                } else {
+                    out << " >=" << upper / 2.0 << ":" << s.histogram[i];
+                }
+            }
+            upper *= 2.0;
+        }
+        out << "\n";
+    }
+
+    return out.str();
+}
+
+MetricsRegistry& MetricsRegistry::shared() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+} // namespace api
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <array>
+#include <mutex>
+#include <cstdint>
+
+namespace api {
+
+// Per-transfer phase timings reported by curl, in milliseconds.
+// appconnect covers the TLS handshake; starttransfer is time to first byte.
+struct TransferTiming {
+    double namelookup_ms = 0.0;
+    double connect_ms = 0.0;
+    double appconnect_ms = 0.0;
+    double starttransfer_ms = 0.0;
+    double total_ms = 0.0;
+};
+
+// Process-wide aggregation of transfer timings, keyed by provider.
+// HttpClient records every completed transfer here; clients and the CLI's
+// --stats dump read the aggregates back out.
+class MetricsRegistry {
+public:
+    // Power-of-two latency buckets for total transfer time:
+    // <1ms, <2ms, <4ms, ... with the last bucket catching everything slower.
+    static constexpr size_t kHistogramBuckets = 16;
+
+    struct ProviderStats {
+        std::uint64_t requests = 0;
+        std::uint64_t failures = 0;
+        TransferTiming sum;
+        double min_total_ms = 0.0;
+        double max_total_ms = 0.0;
+        std::array<std::uint64_t, kHistogramBuckets> histogram{};
+    };
+
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    void record(const std::string& provider, const TransferTiming& timing, bool success);
+
+    std::map<std::string, ProviderStats> snapshot() const;
+
+    // Flattened per-provider aggregates, for surfacing through
+    // IApiClient::getMetrics alongside getConnectionInfo.
+    std::map<std::string, std::string> providerMetrics(const std::string& provider) const;
+
+    // Human-readable per-provider summary for the --stats dump.
+    std::string report() const;
+
+    static MetricsRegistry& shared();
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, ProviderStats> stats_;
+};
+
+} // namespace api
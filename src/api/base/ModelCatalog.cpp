@@ -0,0 +1,118 @@
+#include "ModelCatalog.h"
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace api {
+
+std::vector<std::string> ModelCatalog::getModels(const std::string& provider,
+                                                 const FetchFunction& fetch,
+                                                 const std::vector<std::string>& fallback) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    loadLocked();
+
+    auto it = entries_.find(provider);
+    if (it != entries_.end() &&
+        nowSeconds() - it->second.fetched_at < ttl_.count()) {
+        return it->second.models;
+    }
+
+    // Fetch without holding the lock; a concurrent duplicate fetch is
+    // harmless and cheaper than serializing every caller behind the network.
+    lock.unlock();
+    std::vector<std::string> fetched;
+    if (fetch) {
+        try {
+            fetched = fetch();
+        } catch (const std::exception&) {
+            // Discovery failures fall through to stale/fallback data.
+        }
+    }
+    lock.lock();
+
+    if (!fetched.empty()) {
+        Entry& entry = entries_[provider];
+        entry.fetched_at = nowSeconds();
+        entry.models = fetched;
+        saveLocked();
+        return fetched;
+    }
+
+    // A stale entry still beats a hardcoded list.
+    it = entries_.find(provider);
+    if (it != entries_.end() && !it->second.models.empty()) {
+        return it->second.models;
+    }
+
+    return fallback;
+}
+
+void ModelCatalog::setCachePath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_path_ = path;
+    loaded_ = false;
+    entries_.clear();
+}
+
+void ModelCatalog::setTtl(std::chrono::seconds ttl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ttl_ = ttl;
+}
+
+ModelCatalog& ModelCatalog::shared() {
+    static ModelCatalog catalog;
+    return catalog;
+}
+
+void ModelCatalog::loadLocked() {
+    if (loaded_) {
+        return;
+    }
+    loaded_ = true;
+
+    std::ifstream file(cache_path_);
+    if (!file.is_open()) {
+        return;
+    }
+
+    try {
+        nlohmann::json index;
+        file >> index;
+        for (const auto& item : index.items()) {
+            Entry entry;
+            entry.fetched_at = item.value().value("fetched_at", 0);
+            for (const auto& model : item.value().value("models", nlohmann::json::array())) {
+                if (model.is_string()) {
+                    entry.models.push_back(model);
+                }
+            }
+            entries_[item.key()] = std::move(entry);
+        }
+    } catch (const nlohmann::json::exception&) {
+        // Corrupt index; rebuilt as providers are re-fetched.
+        entries_.clear();
+    }
+}
+
+void ModelCatalog::saveLocked() const {
+    nlohmann::json index;
+    for (const auto& pair : entries_) {
+        index[pair.first] = {
+            {"fetched_at", pair.second.fetched_at},
+            {"models", pair.second.models}
+        };
+    }
+
+    // Failures here just mean the next process re-fetches.
+    std::ofstream file(cache_path_, std::ios::trunc);
+    if (file.is_open()) {
+        file << index.dump(2) << "\n";
+    }
+}
+
+std::int64_t ModelCatalog::nowSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace api
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace api {
+
+// Cached model discovery. Each provider's model list is fetched from its
+// /models endpoint at most once per TTL and persisted to a small on-disk
+// index, so getAvailableModels is accurate without adding a network
+// round-trip to hot paths: after the first fetch a lookup is an in-memory
+// map read.
+class ModelCatalog {
+public:
+    ModelCatalog() = default;
+
+    ModelCatalog(const ModelCatalog&) = delete;
+    ModelCatalog& operator=(const ModelCatalog&) = delete;
+
+    using FetchFunction = std::function<std::vector<std::string>()>;
+
+    // Returns the provider's models, in order of preference: a fresh cache
+    // entry, a live fetch (persisted on success), a stale cache entry, and
+    // finally the caller's fallback list.
+    std::vector<std::string> getModels(const std::string& provider,
+                                       const FetchFunction& fetch,
+                                       const std::vector<std::string>& fallback);
+
+    void setCachePath(const std::string& path);
+    void setTtl(std::chrono::seconds ttl);
+
+    // Process-wide catalog shared by all clients.
+    static ModelCatalog& shared();
+
+private:
+    struct Entry {
+        std::int64_t fetched_at = 0;
+        std::vector<std::string> models;
+    };
+
+    std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::string cache_path_ = "./models.cache.json";
+    std::chrono::seconds ttl_{24 * 60 * 60};
+    bool loaded_ = false;
+
+    void loadLocked();
+    void saveLocked() const;
+
+    static std::int64_t nowSeconds();
+};
+
+} // namespace api
@@ -0,0 +1,61 @@
+#include "PayloadTemplate.h"
+#include <cstdio>
+
+namespace api {
+
+bool PayloadTemplate::compiled() const {
+    return compiled_;
+}
+
+void PayloadTemplate::compile(const std::string& serialized) {
+    auto slot = serialized.find(kSlot);
+    if (slot == std::string::npos ||
+        serialized.find(kSlot, slot + kSlot.size()) != std::string::npos) {
+        compiled_ = false;
+        return;
+    }
+
+    prefix_ = serialized.substr(0, slot);
+    suffix_ = serialized.substr(slot + kSlot.size());
+    compiled_ = true;
+}
+
+void PayloadTemplate::reset() {
+    prefix_.clear();
+    suffix_.clear();
+    compiled_ = false;
+}
+
+void PayloadTemplate::render(std::string_view message, std::string& out) const {
+    out.clear();
+    out.reserve(prefix_.size() + suffix_.size() + message.size() + 16);
+    out += prefix_;
+    appendEscaped(out, message);
+    out += suffix_;
+}
+
+void PayloadTemplate::appendEscaped(std::string& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                                  static_cast<unsigned char>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+}
+
+} // namespace api
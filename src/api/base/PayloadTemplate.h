@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace api {
+
+// Pre-serialized request envelope for traffic that repeats the same settings
+// with only the user message substituted. compile() splits a payload built
+// with the kSlot placeholder message into the invariant prefix and suffix;
+// render() splices the JSON-escaped message between them in a caller-provided
+// buffer, so the hot path never touches the JSON DOM. The template holds no
+// per-render state: concurrent renders of a compiled template are safe.
+class PayloadTemplate {
+public:
+    // Placeholder message compiled into a probe payload; must survive JSON
+    // serialization unescaped and never collide with real field content.
+    static constexpr std::string_view kSlot = "__PAYLOAD_MESSAGE_SLOT__";
+
+    bool compiled() const;
+
+    // Splits `serialized` around kSlot. Stays uncompiled when the slot is
+    // absent (or appears more than once), leaving callers on the DOM path.
+    void compile(const std::string& serialized);
+
+    // Drops the compiled envelope; the next render recompiles against the
+    // client's current settings.
+    void reset();
+
+    // Renders prefix + escaped message + suffix into `out`, replacing its
+    // contents. Callers own the buffer; recycling it through BufferPool
+    // keeps the capacity reuse the template path exists for.
+    void render(std::string_view message, std::string& out) const;
+
+    // Appends `text` JSON-escaped (without surrounding quotes), matching
+    // nlohmann's default dump(): UTF-8 passes through, control characters
+    // and the quote/backslash are escaped.
+    static void appendEscaped(std::string& out, std::string_view text);
+
+private:
+    std::string prefix_;
+    std::string suffix_;
+    bool compiled_ = false;
+};
+
+} // namespace api
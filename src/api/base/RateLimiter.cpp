@@ -0,0 +1,101 @@
+#include "RateLimiter.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace api {
+
+void RateLimiter::configure(const std::string& provider, double requests_per_second, int burst) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& bucket = buckets_[provider];
+    bucket.refill_per_sec = requests_per_second;
+    bucket.capacity = std::max(1, burst);
+    bucket.tokens = bucket.capacity;
+    bucket.last_refill = std::chrono::steady_clock::now();
+}
+
+void RateLimiter::acquire(const std::string& provider) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto it = buckets_.find(provider);
+    if (it == buckets_.end()) {
+        return;
+    }
+    Bucket& bucket = it->second;
+
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+
+        if (now < bucket.paused_until) {
+            available_.wait_until(lock, bucket.paused_until);
+            continue;
+        }
+
+        refill(bucket, now);
+
+        if (bucket.refill_per_sec <= 0.0) {
+            return;
+        }
+
+        if (bucket.tokens >= 1.0) {
+            bucket.tokens -= 1.0;
+            return;
+        }
+
+        auto wait = std::chrono::duration<double>((1.0 - bucket.tokens) / bucket.refill_per_sec);
+        available_.wait_for(lock, std::chrono::duration_cast<std::chrono::milliseconds>(wait));
+    }
+}
+
+void RateLimiter::observeResponse(const std::string& provider, const HttpResponse& response) {
+    // Retry-After accompanies 429s; some providers also announce an empty
+    // window through x-ratelimit-remaining before ever rejecting.
+    double pause_seconds = 0.0;
+
+    if (response.status_code == 429) {
+        pause_seconds = 1.0;
+        if (const auto* retry_after = response.headers.find("Retry-After")) {
+            double parsed = std::atof(retry_after->c_str());
+            if (parsed > 0.0) {
+                pause_seconds = parsed;
+            }
+        }
+    } else if (const auto* remaining = response.headers.find("x-ratelimit-remaining")) {
+        if (*remaining == "0") {
+            pause_seconds = 1.0;
+            if (const auto* reset = response.headers.find("x-ratelimit-reset")) {
+                double parsed = std::atof(reset->c_str());
+                if (parsed > 0.0 && parsed < 3600.0) {
+                    pause_seconds = parsed;
+                }
+            }
+        }
+    }
+
+    if (pause_seconds <= 0.0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& bucket = buckets_[provider];
+    auto resume = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(static_cast<long>(pause_seconds * 1000.0));
+    bucket.paused_until = std::max(bucket.paused_until, resume);
+    bucket.tokens = 0.0;
+}
+
+RateLimiter& RateLimiter::shared() {
+    static RateLimiter limiter;
+    return limiter;
+}
+
+void RateLimiter::refill(Bucket& bucket, std::chrono::steady_clock::time_point now) {
+    if (bucket.refill_per_sec <= 0.0) {
+        return;
+    }
+    std::chrono::duration<double> elapsed = now - bucket.last_refill;
+    bucket.tokens = std::min(bucket.capacity,
+                             bucket.tokens + elapsed.count() * bucket.refill_per_sec);
+    bucket.last_refill = now;
+}
+
+} // namespace api
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "HttpClient.h"
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace api {
+
+// Per-provider token-bucket admission control. Callers block in acquire()
+// until the provider's bucket yields a token, pacing outbound requests at
+// the configured ceiling instead of burning round-trips on 429 responses.
+// Rate-limit feedback from responses (429 status, Retry-After and
+// x-ratelimit-* headers) pauses the bucket so the next attempt waits out
+// the provider's own window.
+class RateLimiter {
+public:
+    RateLimiter() = default;
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Sets the provider's sustained rate and burst size. A rate of zero
+    // disables local pacing; header-driven pauses still apply.
+    void configure(const std::string& provider, double requests_per_second, int burst);
+
+    // Blocks until the provider's bucket admits one request.
+    void acquire(const std::string& provider);
+
+    // Feeds a completed response's rate-limit signals back into the bucket.
+    void observeResponse(const std::string& provider, const HttpResponse& response);
+
+    // Process-wide limiter shared by all HttpClient instances.
+    static RateLimiter& shared();
+
+private:
+    struct Bucket {
+        double tokens = 0.0;
+        double capacity = 1.0;
+        double refill_per_sec = 0.0;
+        std::chrono::steady_clock::time_point last_refill;
+        std::chrono::steady_clock::time_point paused_until;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::map<std::string, Bucket> buckets_;
+
+    static void refill(Bucket& bucket, std::chrono::steady_clock::time_point now);
+};
+
+} // namespace api
@@ -0,0 +1,201 @@
+#include "ResponseCache.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <dirent.h>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+namespace api {
+
+void ResponseCache::configure(const config::CacheConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    enabled_ = config.enabled;
+    if (config.max_entries > 0) {
+        capacity_ = static_cast<size_t>(config.max_entries);
+    }
+    if (!config.path.empty()) {
+        cache_dir_ = config.path;
+    }
+    if (enabled_) {
+        mkdir(cache_dir_.c_str(), 0755);
+    }
+}
+
+std::optional<ApiResponse> ResponseCache::lookup(const std::string& provider,
+                                                 const std::string& payload) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return std::nullopt;
+    }
+
+    auto key = hashKey(provider, payload);
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        // Hash match alone is not identity; a colliding key is a miss.
+        if (it->second->provider != provider || it->second->payload != payload) {
+            return std::nullopt;
+        }
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->response;
+    }
+
+    // Disk hits are promoted into the memory tier.
+    if (auto response = loadFromDisk(key, provider, payload)) {
+        insertLocked(key, provider, payload, *response);
+        return response;
+    }
+
+    return std::nullopt;
+}
+
+void ResponseCache::store(const std::string& provider, const std::string& payload,
+                          const ApiResponse& response) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+        return;
+    }
+
+    auto key = hashKey(provider, payload);
+    insertLocked(key, provider, payload, response);
+    saveToDisk(key, provider, payload, response);
+
+    // Pruning scans the cache directory, so it is amortized over a batch of
+    // stores instead of paid on every one.
+    if (++stores_since_prune_ >= kPruneInterval) {
+        stores_since_prune_ = 0;
+        pruneDiskLocked();
+    }
+}
+
+ResponseCache& ResponseCache::shared() {
+    static ResponseCache cache;
+    return cache;
+}
+
+void ResponseCache::insertLocked(const std::string& key, const std::string& provider,
+                                 const std::string& payload, const ApiResponse& response) {
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        it->second->provider = provider;
+        it->second->payload = payload;
+        it->second->response = response;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+
+    lru_.push_front(Entry{key, provider, payload, response});
+    index_[key] = lru_.begin();
+
+    while (lru_.size() > capacity_) {
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+std::string ResponseCache::entryPath(const std::string& key) const {
+    return cache_dir_ + "/" + key + ".json";
+}
+
+std::optional<ApiResponse> ResponseCache::loadFromDisk(const std::string& key,
+                                                       const std::string& provider,
+                                                       const std::string& payload) const {
+    std::ifstream file(entryPath(key));
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+
+    try {
+        nlohmann::json json;
+        file >> json;
+
+        // Entries record what they were stored under; a colliding key (or a
+        // pre-verification entry without these fields) is a miss.
+        if (json.value("provider", "") != provider || json.value("payload", "") != payload) {
+            return std::nullopt;
+        }
+
+        ApiResponse response;
+        response.content = json.value("content", "");
+        response.status_code = json.value("status_code", 200);
+        response.success = true;
+        return response;
+    } catch (const nlohmann::json::exception&) {
+        return std::nullopt;
+    }
+}
+
+void ResponseCache::saveToDisk(const std::string& key, const std::string& provider,
+                               const std::string& payload, const ApiResponse& response) const {
+    nlohmann::json json = {
+        {"provider", provider},
+        {"payload", payload},
+        {"content", response.content},
+        {"status_code", response.status_code}
+    };
+
+    // Failures here only cost a future network round-trip.
+    std::ofstream file(entryPath(key), std::ios::trunc);
+    if (file.is_open()) {
+        file << json.dump() << "\n";
+    }
+}
+
+void ResponseCache::pruneDiskLocked() const {
+    DIR* dir = opendir(cache_dir_.c_str());
+    if (!dir) {
+        return;
+    }
+
+    std::vector<std::pair<std::time_t, std::string>> entries;
+    while (const dirent* item = readdir(dir)) {
+        std::string name = item->d_name;
+        if (name.size() <= 5 || name.compare(name.size() - 5, 5, ".json") != 0) {
+            continue;
+        }
+        std::string path = cache_dir_ + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            entries.emplace_back(info.st_mtime, std::move(path));
+        }
+    }
+    closedir(dir);
+
+    size_t disk_capacity = capacity_ * kDiskCapacityFactor;
+    if (entries.size() <= disk_capacity) {
+        return;
+    }
+
+    // Evict oldest-first until the tier is back under its bound.
+    std::sort(entries.begin(), entries.end());
+    size_t excess = entries.size() - disk_capacity;
+    for (size_t i = 0; i < excess; ++i) {
+        std::remove(entries[i].second.c_str());
+    }
+}
+
+std::string ResponseCache::hashKey(const std::string& provider, const std::string& payload) {
+    // FNV-1a over provider and payload; collisions are handled by the
+    // stored-identity check on lookup, so 64 bits stays plenty for keying.
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const std::string& data) {
+        for (unsigned char c : data) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(provider);
+    mix(payload);
+
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx",
+                  static_cast<unsigned long long>(hash));
+    return buffer;
+}
+
+} // namespace api
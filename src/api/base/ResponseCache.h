@@ -0,0 +1,77 @@
+#pragma once
+
+#include "IApiClient.h"
+#include "../../config/ApiConfig.h"
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace api {
+
+// Opt-in memoization of sendMessage responses, keyed by a hash of the exact
+// canonical payload the client would put on the wire (model, temperature,
+// max_tokens, messages). Two tiers: an in-memory LRU for the hot set and a
+// persistent on-disk tier (one file per key) that survives restarts, so
+// repeated prompts in nightly runs skip the network entirely.
+//
+// The 64-bit key is a lookup accelerator, not an identity: every entry also
+// records the provider and payload it was stored under, and hits are served
+// only when those match, so a hash collision degrades to a miss instead of
+// returning another request's response.
+class ResponseCache {
+public:
+    ResponseCache() = default;
+
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    void configure(const config::CacheConfig& config);
+
+    // Returns the cached response for this provider/payload pair, promoting
+    // disk hits into the memory tier. Empty when disabled or on miss.
+    std::optional<ApiResponse> lookup(const std::string& provider, const std::string& payload);
+
+    // Stores a successful response in both tiers.
+    void store(const std::string& provider, const std::string& payload,
+               const ApiResponse& response);
+
+    // Process-wide cache shared by all clients.
+    static ResponseCache& shared();
+
+private:
+    struct Entry {
+        std::string key;
+        std::string provider;
+        std::string payload;
+        ApiResponse response;
+    };
+
+    // The disk tier holds this many times the memory capacity; excess
+    // entries are pruned oldest-first, every kPruneInterval stores.
+    static constexpr size_t kDiskCapacityFactor = 4;
+    static constexpr size_t kPruneInterval = 64;
+
+    bool enabled_ = false;
+    size_t capacity_ = 1024;
+    std::string cache_dir_ = "./response-cache";
+    size_t stores_since_prune_ = 0;
+
+    std::mutex mutex_;
+    std::list<Entry> lru_; // front = most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+
+    void insertLocked(const std::string& key, const std::string& provider,
+                      const std::string& payload, const ApiResponse& response);
+    std::string entryPath(const std::string& key) const;
+    std::optional<ApiResponse> loadFromDisk(const std::string& key, const std::string& provider,
+                                            const std::string& payload) const;
+    void saveToDisk(const std::string& key, const std::string& provider,
+                    const std::string& payload, const ApiResponse& response) const;
+    void pruneDiskLocked() const;
+
+    static std::string hashKey(const std::string& provider, const std::string& payload);
+};
+
+} // namespace api
@@ -0,0 +1,58 @@
+#include "RetryPolicy.h"
+#include "HttpClient.h"
+#include <algorithm>
+#include <random>
+
+namespace api {
+
+namespace {
+
+RetryPolicy& defaultPolicy() {
+    static RetryPolicy policy;
+    return policy;
+}
+
+} // namespace
+
+RetryPolicy RetryPolicy::fromConfig(const config::ConnectionPoolConfig& config) {
+    RetryPolicy policy;
+    if (config.retry_attempts > 0) {
+        policy.max_attempts = config.retry_attempts;
+    }
+    if (config.retry_delay > 0) {
+        policy.initial_delay_ms = config.retry_delay;
+    }
+    return policy;
+}
+
+int RetryPolicy::delayForAttempt(int attempt) const {
+    double delay = initial_delay_ms;
+    for (int i = 1; i < attempt; ++i) {
+        delay *= backoff_multiplier;
+    }
+    delay = std::min(delay, static_cast<double>(max_delay_ms));
+
+    // Equal jitter: keep half the backoff, randomize the other half.
+    static thread_local std::mt19937 rng{std::random_device{}()};
+    std::uniform_real_distribution<double> jitter(0.5, 1.0);
+    return static_cast<int>(delay * jitter(rng));
+}
+
+bool RetryPolicy::shouldRetry(const HttpResponse& response) {
+    if (response.success) {
+        return false;
+    }
+    return response.status_code == 429 ||
+           response.status_code >= 500 ||
+           response.status_code == 0;
+}
+
+const RetryPolicy& RetryPolicy::defaults() {
+    return defaultPolicy();
+}
+
+void RetryPolicy::setDefaults(const RetryPolicy& policy) {
+    defaultPolicy() = policy;
+}
+
+} // namespace api
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../../config/ApiConfig.h"
+
+namespace api {
+
+struct HttpResponse;
+
+// Exponential backoff schedule for transient HTTP failures. The attempt
+// count and base delay come from ConnectionPoolConfig (retry_attempts,
+// retry_delay); each retry doubles the delay and applies jitter so a burst
+// of failing callers does not retry in lockstep.
+struct RetryPolicy {
+    int max_attempts = 3;       // total tries, including the first
+    int initial_delay_ms = 1000;
+    double backoff_multiplier = 2.0;
+    int max_delay_ms = 30000;
+
+    static RetryPolicy fromConfig(const config::ConnectionPoolConfig& config);
+
+    // Delay to sleep before retry number `attempt` (1 = first retry),
+    // exponentially grown, capped, and jittered into [delay/2, delay].
+    int delayForAttempt(int attempt) const;
+
+    // Transient failures worth retrying: rate limits, server errors, and
+    // transport-level failures that never produced a status code.
+    static bool shouldRetry(const HttpResponse& response);
+
+    // Process-wide defaults applied to each HttpClient at construction;
+    // configured once by ApiFactory from the loaded ConnectionPoolConfig.
+    static const RetryPolicy& defaults();
+    static void setDefaults(const RetryPolicy& policy);
+};
+
+} // namespace api
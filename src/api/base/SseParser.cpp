@@ -0,0 +1,48 @@
+#include "SseParser.h"
+
+namespace api {
+
+SseParser::SseParser(EventCallback on_event)
+    : on_event_(std::move(on_event)) {
+}
+
+void SseParser::feed(const char* data, size_t length) {
+    buffer_.append(data, length);
+
+    size_t newline_pos;
+    while ((newline_pos = buffer_.find('\n')) != std::string::npos) {
+        std::string line = buffer_.substr(0, newline_pos);
+        buffer_.erase(0, newline_pos + 1);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        processLine(line);
+    }
+}
+
+void SseParser::reset() {
+    buffer_.clear();
+}
+
+void SseParser::processLine(const std::string& line) {
+    // Only "data:" fields carry payloads; "event:" lines, comments and blank
+    // event separators are ignored here.
+    static const std::string prefix = "data:";
+    if (line.compare(0, prefix.size(), prefix) != 0) {
+        return;
+    }
+
+    size_t start = prefix.size();
+    if (start < line.size() && line[start] == ' ') {
+        ++start;
+    }
+
+    std::string payload = line.substr(start);
+    if (!payload.empty() && on_event_) {
+        on_event_(payload);
+    }
+}
+
+} // namespace api
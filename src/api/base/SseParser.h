@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <functional>
+
+namespace api {
+
+// Incremental parser for Server-Sent Events (SSE) streams.
+// Feed it raw transfer chunks as they arrive from the write callback and it
+// invokes the event callback once per complete "data:" event payload.
+class SseParser {
+public:
+    using EventCallback = std::function<void(const std::string& data)>;
+
+    explicit SseParser(EventCallback on_event);
+
+    void feed(const char* data, size_t length);
+
+    void reset();
+
+private:
+    EventCallback on_event_;
+    std::string buffer_;
+
+    void processLine(const std::string& line);
+};
+
+} // namespace api
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <coroutine>
+#include <optional>
+#include <exception>
+#include <semaphore>
+#include <utility>
+
+namespace api {
+
+// Lazily-started coroutine task. Awaiting a Task starts it and resumes the
+// awaiter when it finishes; get() bridges back to synchronous code by
+// blocking the calling thread until the task completes. Completion happens
+// on whichever thread fulfils the awaited operation (for HTTP transfers,
+// the curl_multi event-loop thread), so thousands of in-flight tasks share
+// a handful of OS threads instead of one blocked thread each.
+template <typename T>
+class Task {
+public:
+    struct promise_type {
+        std::optional<T> value_;
+        std::exception_ptr exception_;
+        std::coroutine_handle<> continuation_;
+        std::binary_semaphore* sync_done_ = nullptr;
+
+        Task get_return_object() {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                auto& promise = handle.promise();
+                if (promise.continuation_) {
+                    return promise.continuation_;
+                }
+                if (promise.sync_done_) {
+                    promise.sync_done_->release();
+                }
+                return std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(T value) { value_ = std::move(value); }
+
+        void unhandled_exception() { exception_ = std::current_exception(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) {
+        handle_.promise().continuation_ = continuation;
+        return handle_;
+    }
+
+    T await_resume() {
+        auto& promise = handle_.promise();
+        if (promise.exception_) {
+            std::rethrow_exception(promise.exception_);
+        }
+        return std::move(*promise.value_);
+    }
+
+    // Runs the task to completion, blocking the calling thread.
+    T get() {
+        std::binary_semaphore done(0);
+        handle_.promise().sync_done_ = &done;
+        handle_.resume();
+        done.acquire();
+        return await_resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+} // namespace api
@@ -0,0 +1,194 @@
+#include "Telemetry.h"
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace api {
+
+namespace {
+
+// Bucket index for a millisecond value under the power-of-two scheme.
+size_t bucketFor(double value_ms, size_t bucket_count) {
+    size_t bucket = 0;
+    double upper = 1.0;
+    while (bucket + 1 < bucket_count && value_ms >= upper) {
+        upper *= 2.0;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void copyLabel(char* dest, size_t capacity, std::string_view label) {
+    if (label.empty()) {
+        label = "-";
+    }
+    size_t length = std::min(label.size(), capacity - 1);
+    std::memcpy(dest, label.data(), length);
+    dest[length] = '\0';
+}
+
+} // namespace
+
+Telemetry::Telemetry() : started_(std::chrono::steady_clock::now()) {
+    for (size_t i = 0; i < kRingSize; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    aggregator_ = std::thread(&Telemetry::run, this);
+}
+
+Telemetry::~Telemetry() {
+    running_.store(false, std::memory_order_release);
+    if (aggregator_.joinable()) {
+        aggregator_.join();
+    }
+}
+
+void Telemetry::emit(EventType type, std::string_view provider,
+                     std::string_view model, double value_ms) {
+    Event event;
+    event.type = type;
+    event.value_ms = value_ms;
+    copyLabel(event.provider, kLabelSize, provider);
+    copyLabel(event.model, kLabelSize, model);
+
+    if (!tryPush(event)) {
+        // Telemetry must never stall a request: on overflow the event is
+        // dropped and only the loss itself is recorded.
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Telemetry::tryPush(const Event& event) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & (kRingSize - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.event = event;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // ring full
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Telemetry::tryPop(Event& event) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & (kRingSize - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                event = slot.event;
+                slot.sequence.store(pos + kRingSize, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // ring empty
+        } else {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Telemetry::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            drainInto(stats_);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // Final drain so events emitted just before shutdown are counted.
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    drainInto(stats_);
+}
+
+void Telemetry::drainInto(std::map<std::string, SeriesStats>& stats) {
+    Event event;
+    while (tryPop(event)) {
+        auto& series = stats[std::string(event.provider) + "/" + event.model];
+        switch (event.type) {
+            case EventType::Enqueue:
+                ++series.enqueued;
+                break;
+            case EventType::Send:
+                ++series.sent;
+                break;
+            case EventType::FirstByte:
+                series.sum_firstbyte_ms += event.value_ms;
+                ++series.firstbyte_histogram[bucketFor(event.value_ms, kHistogramBuckets)];
+                break;
+            case EventType::Complete:
+                ++series.completed;
+                series.sum_total_ms += event.value_ms;
+                ++series.total_histogram[bucketFor(event.value_ms, kHistogramBuckets)];
+                break;
+            case EventType::Error:
+                ++series.errors;
+                break;
+        }
+    }
+}
+
+std::map<std::string, Telemetry::SeriesStats> Telemetry::snapshot() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+std::uint64_t Telemetry::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+std::string Telemetry::report() const {
+    auto stats = snapshot();
+    auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started_).count();
+
+    std::ostringstream out;
+    out << "Request telemetry:\n";
+    if (stats.empty()) {
+        out << "  (no events recorded)\n";
+        return out.str();
+    }
+
+    for (const auto& [series, s] : stats) {
+        out << "  " << series << ":\n";
+        out << "    enqueued: " << s.enqueued
+            << "  sent: " << s.sent
+            << "  completed: " << s.completed
+            << "  errors: " << s.errors << "\n";
+        if (s.completed > 0) {
+            out << "    avg total: " << (s.sum_total_ms / s.completed) << " ms"
+                << "  throughput: " << (elapsed > 0.0 ? s.completed / elapsed : 0.0)
+                << " req/s\n";
+            out << "    total latency histogram (ms):";
+            double upper = 1.0;
+            for (size_t i = 0; i < kHistogramBuckets; ++i) {
+                if (s.total_histogram[i] > 0) {
+                    out << "  <" << upper << ": " << s.total_histogram[i];
+                }
+                upper *= 2.0;
+            }
+            out << "\n";
+        }
+    }
+    if (dropped() > 0) {
+        out << "  dropped events: " << dropped() << "\n";
+    }
+    return out.str();
+}
+
+Telemetry& Telemetry::shared() {
+    static Telemetry telemetry;
+    return telemetry;
+}
+
+} // namespace api
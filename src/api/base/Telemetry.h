@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace api {
+
+// Continuous request-lifecycle telemetry. Producers on any thread write
+// fixed-size events into a bounded lock-free ring buffer (emit never blocks
+// and never allocates; when the ring is full the event is dropped and
+// counted). A background aggregator drains the ring into per-provider,
+// per-model latency histograms and throughput counters, which the CLI dumps
+// via --telemetry and code can query through snapshot().
+class Telemetry {
+public:
+    enum class EventType : std::uint8_t {
+        Enqueue,   // request handed to the transport
+        Send,      // dispatched after rate limiting
+        FirstByte, // value_ms = time to first byte
+        Complete,  // value_ms = total transfer time
+        Error      // value_ms = total transfer time (when known)
+    };
+
+    // Same power-of-two bucket scheme as MetricsRegistry: <1ms, <2ms, <4ms,
+    // ... with the last bucket catching everything slower.
+    static constexpr size_t kHistogramBuckets = 16;
+
+    // Per provider/model aggregates, as drained so far.
+    struct SeriesStats {
+        std::uint64_t enqueued = 0;
+        std::uint64_t sent = 0;
+        std::uint64_t completed = 0;
+        std::uint64_t errors = 0;
+        double sum_total_ms = 0.0;
+        double sum_firstbyte_ms = 0.0;
+        std::array<std::uint64_t, kHistogramBuckets> total_histogram{};
+        std::array<std::uint64_t, kHistogramBuckets> firstbyte_histogram{};
+    };
+
+    Telemetry();
+    ~Telemetry();
+
+    Telemetry(const Telemetry&) = delete;
+    Telemetry& operator=(const Telemetry&) = delete;
+
+    // Wait-free for producers. Labels longer than the slot capacity are
+    // truncated; empty labels are stored as "-".
+    void emit(EventType type, std::string_view provider,
+              std::string_view model, double value_ms = 0.0);
+
+    // Aggregates drained so far, keyed "provider/model".
+    std::map<std::string, SeriesStats> snapshot() const;
+
+    // Events discarded because the ring was full.
+    std::uint64_t dropped() const;
+
+    // Human-readable per-series summary, including completion rates since
+    // process start, for the --telemetry dump.
+    std::string report() const;
+
+    static Telemetry& shared();
+
+private:
+    static constexpr size_t kRingSize = 4096; // power of two
+    static constexpr size_t kLabelSize = 48;
+
+    struct Event {
+        EventType type;
+        double value_ms;
+        char provider[kLabelSize];
+        char model[kLabelSize];
+    };
+
+    // Bounded MPMC slot: `sequence` ticks through the Vyukov protocol so
+    // producers claim and consumers release slots without locks.
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Event event;
+    };
+
+    bool tryPush(const Event& event);
+    bool tryPop(Event& event);
+    void run();
+    void drainInto(std::map<std::string, SeriesStats>& stats);
+
+    std::array<Slot, kRingSize> ring_;
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // Aggregates are only ever touched under this mutex, by the aggregator
+    // thread and by readers; producers never take it.
+    mutable std::mutex stats_mutex_;
+    std::map<std::string, SeriesStats> stats_;
+    std::chrono::steady_clock::time_point started_;
+
+    std::atomic<bool> running_{true};
+    std::thread aggregator_;
+};
+
+} // namespace api
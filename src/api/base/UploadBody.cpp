@@ -0,0 +1,219 @@
+#include "UploadBody.h"
+#include "ApiException.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace api {
+
+namespace {
+
+// Escaped form of one byte under the same scheme as
+// PayloadTemplate::appendEscaped; returns the encoded length, 1 for bytes
+// that pass through unchanged.
+size_t encodeByte(char c, char encoded[8]) {
+    switch (c) {
+        case '"':  std::memcpy(encoded, "\\\"", 2); return 2;
+        case '\\': std::memcpy(encoded, "\\\\", 2); return 2;
+        case '\b': std::memcpy(encoded, "\\b", 2); return 2;
+        case '\f': std::memcpy(encoded, "\\f", 2); return 2;
+        case '\n': std::memcpy(encoded, "\\n", 2); return 2;
+        case '\r': std::memcpy(encoded, "\\r", 2); return 2;
+        case '\t': std::memcpy(encoded, "\\t", 2); return 2;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                std::snprintf(encoded, 8, "\\u%04x", static_cast<unsigned char>(c));
+                return 6;
+            }
+            encoded[0] = c;
+            return 1;
+    }
+}
+
+bool needsEscape(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+size_t escapedLength(const char* data, size_t size) {
+    size_t length = 0;
+    char encoded[8];
+    for (size_t i = 0; i < size; ++i) {
+        length += needsEscape(data[i]) ? encodeByte(data[i], encoded) : 1;
+    }
+    return length;
+}
+
+} // namespace
+
+MappedFile::MappedFile(void* data, size_t size) : data_(data), size_(size) {
+}
+
+MappedFile::~MappedFile() {
+    if (data_ != nullptr && size_ > 0) {
+        munmap(data_, size_);
+    }
+}
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw InvalidRequestException("Failed to open context file: " + path);
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        throw InvalidRequestException("Failed to stat context file: " + path);
+    }
+
+    size_t size = static_cast<size_t>(file_stat.st_size);
+    if (size == 0) {
+        close(fd);
+        return std::shared_ptr<MappedFile>(new MappedFile(nullptr, 0));
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw InvalidRequestException("Failed to map context file: " + path);
+    }
+
+    // The body is consumed front to back exactly once per transfer.
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    return std::shared_ptr<MappedFile>(new MappedFile(data, size));
+}
+
+size_t UploadBody::Segment::sourceSize() const {
+    return kind == Kind::Literal ? literal.size() : file->size();
+}
+
+size_t UploadBody::Segment::encodedSize() const {
+    if (kind != Kind::JsonText) {
+        return sourceSize();
+    }
+    if (!encoded_size_known) {
+        encoded_size = escapedLength(file->data(), file->size());
+        encoded_size_known = true;
+    }
+    return encoded_size;
+}
+
+void UploadBody::append(std::string literal) {
+    if (literal.empty()) {
+        return;
+    }
+    Segment segment;
+    segment.kind = Segment::Kind::Literal;
+    segment.literal = std::move(literal);
+    segments_.push_back(std::move(segment));
+}
+
+void UploadBody::appendFile(std::shared_ptr<MappedFile> file) {
+    if (!file || file->size() == 0) {
+        return;
+    }
+    Segment segment;
+    segment.kind = Segment::Kind::Raw;
+    segment.file = std::move(file);
+    segments_.push_back(std::move(segment));
+}
+
+void UploadBody::appendJsonEscaped(std::shared_ptr<MappedFile> file) {
+    if (!file || file->size() == 0) {
+        return;
+    }
+    Segment segment;
+    segment.kind = Segment::Kind::JsonText;
+    segment.file = std::move(file);
+    segments_.push_back(std::move(segment));
+}
+
+size_t UploadBody::contentLength() const {
+    size_t total = 0;
+    for (const auto& segment : segments_) {
+        total += segment.encodedSize();
+    }
+    return total;
+}
+
+size_t UploadBody::read(char* dest, size_t capacity) {
+    size_t written = 0;
+
+    // Finish any escape sequence split across the previous buffer boundary.
+    if (carry_offset_ < carry_.size()) {
+        size_t take = std::min(capacity, carry_.size() - carry_offset_);
+        std::memcpy(dest, carry_.data() + carry_offset_, take);
+        carry_offset_ += take;
+        written += take;
+    }
+
+    while (written < capacity && segment_index_ < segments_.size()) {
+        const Segment& segment = segments_[segment_index_];
+        size_t source_size = segment.sourceSize();
+
+        if (source_offset_ >= source_size) {
+            ++segment_index_;
+            source_offset_ = 0;
+            continue;
+        }
+
+        if (segment.kind != Segment::Kind::JsonText) {
+            const char* source = segment.kind == Segment::Kind::Literal
+                                     ? segment.literal.data()
+                                     : segment.file->data();
+            size_t take = std::min(capacity - written, source_size - source_offset_);
+            std::memcpy(dest + written, source + source_offset_, take);
+            source_offset_ += take;
+            written += take;
+            continue;
+        }
+
+        const char* source = segment.file->data();
+        while (written < capacity && source_offset_ < source_size) {
+            char c = source[source_offset_];
+            if (!needsEscape(c)) {
+                // Bulk-copy the run of bytes that pass through unescaped.
+                size_t run_end = source_offset_;
+                size_t limit = std::min(source_size,
+                                        source_offset_ + (capacity - written));
+                while (run_end < limit && !needsEscape(source[run_end])) {
+                    ++run_end;
+                }
+                size_t take = run_end - source_offset_;
+                std::memcpy(dest + written, source + source_offset_, take);
+                source_offset_ = run_end;
+                written += take;
+                continue;
+            }
+
+            char encoded[8];
+            size_t encoded_length = encodeByte(c, encoded);
+            size_t take = std::min(encoded_length, capacity - written);
+            std::memcpy(dest + written, encoded, take);
+            written += take;
+            ++source_offset_;
+            if (take < encoded_length) {
+                // The rest of the sequence leads the next read.
+                carry_.assign(encoded + take, encoded_length - take);
+                carry_offset_ = 0;
+                return written;
+            }
+        }
+    }
+
+    return written;
+}
+
+void UploadBody::rewind() {
+    segment_index_ = 0;
+    source_offset_ = 0;
+    carry_.clear();
+    carry_offset_ = 0;
+}
+
+} // namespace api
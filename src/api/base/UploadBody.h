@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace api {
+
+// Read-only memory-mapped file. The mapping lives for the lifetime of the
+// object, so segments referencing it stream straight from the page cache
+// without the contents ever being copied onto the heap.
+class MappedFile {
+public:
+    // Maps `path` read-only; throws InvalidRequestException when the file
+    // cannot be opened or mapped.
+    static std::shared_ptr<MappedFile> open(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return static_cast<const char*>(data_); }
+    size_t size() const { return size_; }
+
+private:
+    MappedFile(void* data, size_t size);
+
+    void* data_;
+    size_t size_;
+};
+
+// Request body assembled from heap-owned literals and memory-mapped file
+// segments, consumed incrementally through curl's read callback instead of
+// being materialized as one contiguous string. Mapped segments can be
+// spliced verbatim or JSON-escaped on the fly, so a multi-megabyte document
+// embedded in a JSON string field costs no heap copy either: bytes move from
+// the page cache into curl's transfer buffer, escaping applied in between.
+//
+// The read cursor is single-stream state: one body feeds one transfer at a
+// time, and a retry must rewind() before reusing it.
+class UploadBody {
+public:
+    // Appends a heap-owned piece, e.g. the serialized JSON envelope around a
+    // mapped document.
+    void append(std::string literal);
+
+    // Appends the file's bytes verbatim.
+    void appendFile(std::shared_ptr<MappedFile> file);
+
+    // Appends the file's bytes JSON-escaped (without surrounding quotes),
+    // matching PayloadTemplate::appendEscaped byte for byte.
+    void appendJsonEscaped(std::shared_ptr<MappedFile> file);
+
+    // Total bytes the body produces, escaping included. The escaped size of
+    // mapped segments is counted once and cached.
+    size_t contentLength() const;
+
+    // Copies up to `capacity` bytes at the cursor into `dest` and advances;
+    // returns the number written, 0 at end of body.
+    size_t read(char* dest, size_t capacity);
+
+    void rewind();
+
+    bool empty() const { return segments_.empty(); }
+
+private:
+    struct Segment {
+        enum class Kind { Literal, Raw, JsonText };
+        Kind kind;
+        std::string literal;
+        std::shared_ptr<MappedFile> file;
+        // Escaped size for JsonText segments, computed lazily.
+        mutable size_t encoded_size = 0;
+        mutable bool encoded_size_known = false;
+
+        size_t sourceSize() const;
+        size_t encodedSize() const;
+    };
+
+    std::vector<Segment> segments_;
+
+    // Cursor: current segment, bytes of its *source* consumed, plus any tail
+    // of an escape sequence that did not fit the previous read's buffer.
+    size_t segment_index_ = 0;
+    size_t source_offset_ = 0;
+    std::string carry_;
+    size_t carry_offset_ = 0;
+};
+
+} // namespace api
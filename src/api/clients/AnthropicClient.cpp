@@ -1,5 +1,13 @@
 #include "AnthropicClient.h"
 #include "../base/ApiException.h"
+#include "../base/AsyncHttpClient.h"
+#include "../base/RateLimiter.h"
+#include "../base/BufferPool.h"
+#include "../base/ModelCatalog.h"
+#include "../base/ResponseCache.h"
+#include "../base/SseParser.h"
+#include "../base/JsonExtractor.h"
+#include "../base/Metrics.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -12,39 +20,133 @@ AnthropicClient::AnthropicClient(const config::ApiConfig& config)
     http_client_ = std::make_unique<HttpClient>();
     http_client_->setDefaultTimeout(config_.timeout);
     http_client_->setUserAgent("AI-CLI-Anthropic/1.0");
+    http_client_->setMetricsLabel(getProviderName());
+
+    if (config_.rate_limit.requests_per_second > 0.0) {
+        RateLimiter::shared().configure(getProviderName(),
+                                        config_.rate_limit.requests_per_second,
+                                        config_.rate_limit.burst);
+    }
 
     if (config_.auth.token.empty()) {
         throw ConfigException("Anthropic API key not found in environment variable: " + config_.auth.env_var);
     }
 
-    try {
-        testConnection();
-        connected_ = true;
-    } catch (const std::exception& e) {
-        std::cerr << "Warning: Failed to test Anthropic connection: " << e.what() << std::endl;
-        connected_ = false;
+    // The header set depends only on fixed configuration, so it is built
+    // here once and reused by every request; only the payload varies.
+    base_headers_.set("Content-Type", "application/json");
+    base_headers_.set("anthropic-version", "2023-06-01");
+    if (config_.auth.type == "header") {
+        base_headers_.set(config_.auth.header_name, config_.auth.token);
     }
+
+    // Connectivity is validated lazily: construction stays network-free and
+    // the first real request doubles as the probe.
 }
 
 ApiResponse AnthropicClient::sendMessage(const MessageRequest& request) {
-    if (!connected_) {
-        testConnection();
+    auto endpoint_url = buildEndpointUrl("messages");
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+
+    // Mapped contexts stream straight out of the page cache and skip the
+    // response cache: hashing the payload would force the very copy this
+    // path exists to avoid.
+    if (!request.context_file.empty()) {
+        try {
+            auto http_response = http_client_->post(endpoint_url, buildMappedPayload(request), headers);
+            if (http_response.success) {
+                connected_ = true;
+            }
+            return parseResponse(http_response);
+        } catch (const std::exception& e) {
+            throw ApiException("Anthropic API request failed: " + std::string(e.what()));
+        }
     }
 
-    auto endpoint_url = buildEndpointUrl("messages");
-    auto headers = buildHeaders();
     auto payload = buildMessagePayload(request);
 
+    // Identical payloads are answered from the shared response cache when it
+    // is enabled; a large share of batch traffic repeats prompts verbatim.
+    if (auto cached = ResponseCache::shared().lookup(getProviderName(), payload)) {
+        BufferPool::shared().release(std::move(payload));
+        return *cached;
+    }
+
     try {
         auto http_response = http_client_->post(endpoint_url, payload, headers);
-        return parseResponse(http_response);
+        if (http_response.success) {
+            connected_ = true;
+        }
+        auto api_response = parseResponse(http_response);
+        if (api_response.success) {
+            ResponseCache::shared().store(getProviderName(), payload, api_response);
+        }
+        BufferPool::shared().release(std::move(payload));
+        return api_response;
+    } catch (const std::exception& e) {
+        throw ApiException("Anthropic API request failed: " + std::string(e.what()));
+    }
+}
+
+ApiResponse AnthropicClient::sendMessageStream(const MessageRequest& request,
+                                               const StreamCallback& on_chunk) {
+    auto endpoint_url = buildEndpointUrl("messages");
+    HeaderMap headers = buildHeaders();
+    headers.set("Accept", "text/event-stream");
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    auto payload = buildMessagePayload(request, true);
+
+    std::string content;
+    SseParser parser([&](const std::string& event) {
+        auto text = parseStreamEvent(event);
+        if (!text.empty()) {
+            content += text;
+            if (on_chunk) {
+                on_chunk(text);
+            }
+        }
+    });
+
+    try {
+        auto http_response = http_client_->postStream(endpoint_url, payload, headers,
+            [&](const char* data, size_t length) {
+                parser.feed(data, length);
+            });
+
+        if (http_response.success) {
+            connected_ = true;
+        }
+
+        ApiResponse response;
+        response.status_code = http_response.status_code;
+        response.headers = http_response.headers;
+        response.success = http_response.success;
+        response.error_message = http_response.error_message;
+        response.content = http_response.success ? content : http_response.body;
+        return response;
     } catch (const std::exception& e) {
         throw ApiException("Anthropic API request failed: " + std::string(e.what()));
     }
 }
 
+Task<ApiResponse> AnthropicClient::co_sendMessage(MessageRequest request) {
+    auto endpoint_url = buildEndpointUrl("messages");
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    std::string payload = buildMessagePayload(request);
+
+    auto http_response = co_await http_client_->coPost(endpoint_url, payload, headers);
+    if (http_response.success) {
+        connected_ = true;
+    }
+    co_return parseResponse(http_response);
+}
+
 std::vector<std::string> AnthropicClient::getAvailableModels() {
-    std::vector<std::string> models = {
+    // Discovery goes through the shared TTL cache; the hardcoded
+    // list survives only as the fallback when every fetch fails.
+    static const std::vector<std::string> kFallbackModels = {
         "claude-3-opus-20240229",
         "claude-3-sonnet-20240229",
         "claude-3-haiku-20240307",
@@ -52,11 +154,39 @@ std::vector<std::string> AnthropicClient::getAvailableModels() {
         "claude-2.0",
         "claude-instant-1.2"
     };
-    return models;
+    return ModelCatalog::shared().getModels(getProviderName(),
+                                            [this] { return fetchModels(); },
+                                            kFallbackModels);
+}
+
+std::vector<std::string> AnthropicClient::fetchModels() const {
+    auto it = config_.endpoints.endpoints.find("models");
+    if (it == config_.endpoints.endpoints.end()) {
+        return {};
+    }
+
+    try {
+        auto http_response = http_client_->get(config_.base_url + it->second, buildHeaders());
+        if (!http_response.success) {
+            return {};
+        }
+
+        std::vector<std::string> models;
+        auto json = nlohmann::json::parse(http_response.body);
+        for (const auto& item : json.value("data", nlohmann::json::array())) {
+            if (item.contains("id") && item["id"].is_string()) {
+                models.push_back(item["id"]);
+            }
+        }
+        return models;
+    } catch (const std::exception&) {
+        return {};
+    }
 }
 
 void AnthropicClient::setModel(const std::string& model) {
     current_model_ = model;
+    payload_template_.reset();
 }
 
 std::string AnthropicClient::getCurrentModel() const {
@@ -65,10 +195,12 @@ std::string AnthropicClient::getCurrentModel() const {
 
 void AnthropicClient::setMaxTokens(int max_tokens) {
     max_tokens_ = max_tokens;
+    payload_template_.reset();
 }
 
 void AnthropicClient::setTemperature(double temperature) {
     temperature_ = temperature;
+    payload_template_.reset();
 }
 
 bool AnthropicClient::isConnected() const {
@@ -81,7 +213,7 @@ std::string AnthropicClient::getProviderName() const {
 
 void AnthropicClient::testConnection() {
     auto endpoint_url = buildEndpointUrl("messages");
-    auto headers = buildHeaders();
+    const auto& headers = buildHeaders();
 
     // Send a minimal test request
     nlohmann::json test_payload = {
@@ -107,6 +239,10 @@ void AnthropicClient::testConnection() {
     }
 }
 
+std::map<std::string, std::string> AnthropicClient::getMetrics() const {
+    return MetricsRegistry::shared().providerMetrics(getProviderName());
+}
+
 std::map<std::string, std::string> AnthropicClient::getConnectionInfo() const {
     return {
         {"provider", getProviderName()},
@@ -126,22 +262,49 @@ std::string AnthropicClient::buildEndpointUrl(const std::string& endpoint) const
     return config_.base_url + it->second;
 }
 
-std::map<std::string, std::string> AnthropicClient::buildHeaders() const {
-    std::map<std::string, std::string> headers;
-
-    headers["Content-Type"] = "application/json";
-    headers["anthropic-version"] = "2023-06-01";
+const HeaderMap& AnthropicClient::buildHeaders() const {
+    return base_headers_;
+}
 
-    if (config_.auth.type == "header") {
-        headers[config_.auth.header_name] = config_.auth.token;
+std::string AnthropicClient::buildMessagePayload(const MessageRequest& request, bool stream) const {
+    // Batch traffic repeats the same settings with only the user message
+    // substituted; serialize the invariant envelope once and splice the
+    // escaped message into a pooled buffer instead of rebuilding the DOM.
+    bool template_eligible = !stream && request.model.empty() &&
+                             request.max_tokens <= 0 && request.temperature < 0 &&
+                             request.stop_sequences.empty() && request.history.empty() &&
+                             request.serialized_messages.empty() &&
+                             request.context_file.empty();
+    if (template_eligible) {
+        if (!payload_template_.compiled()) {
+            MessageRequest probe;
+            probe.message = std::string(PayloadTemplate::kSlot);
+            probe.max_tokens = 0;
+            probe.temperature = -1.0;
+            payload_template_.compile(buildMessagePayloadDom(probe, false));
+        }
+        if (payload_template_.compiled()) {
+            std::string payload = BufferPool::shared().acquire();
+            payload_template_.render(request.message, payload);
+            return payload;
+        }
     }
 
-    return headers;
+    return buildMessagePayloadDom(request, stream);
 }
 
-std::string AnthropicClient::buildMessagePayload(const MessageRequest& request) const {
+std::string AnthropicClient::buildMessagePayloadDom(const MessageRequest& request, bool stream) const {
     nlohmann::json payload;
 
+    // Fallback used by the paths that materialize the payload (streaming,
+    // coroutines, templates): the context is appended to the message here;
+    // sendMessage streams it zero-copy instead.
+    std::string message = request.message;
+    if (!request.context_file.empty()) {
+        auto context = MappedFile::open(request.context_file);
+        message.append(context->data(), context->size());
+    }
+
     payload["model"] = request.model.empty() ? current_model_ : request.model;
     payload["max_tokens"] = request.max_tokens > 0 ? request.max_tokens : max_tokens_;
 
@@ -155,14 +318,72 @@ std::string AnthropicClient::buildMessagePayload(const MessageRequest& request)
         payload["stop_sequences"] = request.stop_sequences;
     }
 
-    payload["messages"] = nlohmann::json::array({
-        {{"role", "user"}, {"content", request.message}}
-    });
+    if (stream) {
+        payload["stream"] = true;
+    }
+
+    // A pre-serialized transcript (from Conversation's incremental cache) is
+    // spliced in verbatim; prior turns were serialized once when added.
+    if (!request.serialized_messages.empty()) {
+        std::string out = payload.dump();
+        out.insert(out.size() - 1, ",\"messages\":" + request.serialized_messages);
+        return out;
+    }
+
+    auto messages = nlohmann::json::array();
+    for (const auto& turn : request.history) {
+        messages.push_back({{"role", turn.role}, {"content", turn.content}});
+    }
+    messages.push_back({{"role", "user"}, {"content", message}});
+    payload["messages"] = std::move(messages);
 
     return payload.dump();
 }
 
-ApiResponse AnthropicClient::parseResponse(const HttpResponse& http_response) const {
+std::shared_ptr<UploadBody> AnthropicClient::buildMappedPayload(const MessageRequest& request) const {
+    // Serialize the envelope with the slot sentinel appended to the user
+    // message, then splice the mapped document through the slot position: its
+    // bytes flow from the page cache into the transfer with JSON escaping
+    // applied on the fly, never materialized in a payload string.
+    MessageRequest probe = request;
+    probe.context_file.clear();
+    probe.message += PayloadTemplate::kSlot;
+    std::string serialized = buildMessagePayloadDom(probe, false);
+    auto slot = serialized.find(PayloadTemplate::kSlot);
+
+    auto body = std::make_shared<UploadBody>();
+    if (slot == std::string::npos) {
+        // Pre-serialized transcripts embed the message elsewhere; fall back
+        // to the materialized payload with the context appended.
+        body->append(buildMessagePayloadDom(request, false));
+        return body;
+    }
+
+    body->append(serialized.substr(0, slot));
+    body->appendJsonEscaped(MappedFile::open(request.context_file));
+    body->append(serialized.substr(slot + PayloadTemplate::kSlot.size()));
+    return body;
+}
+
+std::string AnthropicClient::parseStreamEvent(const std::string& event) const {
+    // Anthropic emits typed events; only content_block_delta events carry
+    // generated text, as {"type":"content_block_delta","delta":{"text":...}}.
+    try {
+        auto json_event = nlohmann::json::parse(event);
+
+        if (json_event.contains("type") && json_event["type"] == "content_block_delta" &&
+            json_event.contains("delta") && json_event["delta"].contains("text") &&
+            json_event["delta"]["text"].is_string()) {
+            return json_event["delta"]["text"];
+        }
+    } catch (const nlohmann::json::exception&) {
+        // Ignore malformed or non-JSON events (e.g. ping keepalives).
+    }
+
+    return {};
+}
+
+ApiResponse AnthropicClient::parseResponse(HttpResponse& http_response) const {
     ApiResponse response;
     response.status_code = http_response.status_code;
     response.headers = http_response.headers;
@@ -170,28 +391,26 @@ ApiResponse AnthropicClient::parseResponse(const HttpResponse& http_response) co
     response.error_message = http_response.error_message;
 
     if (!http_response.success) {
-        response.content = http_response.body;
+        response.content = std::move(http_response.body);
         return response;
     }
 
-    try {
-        auto json_response = nlohmann::json::parse(http_response.body);
-
-        if (json_response.contains("content") && json_response["content"].is_array() &&
-            !json_response["content"].empty()) {
-            auto first_content = json_response["content"][0];
-            if (first_content.contains("text") && first_content["text"].is_string()) {
-                response.content = first_content["text"];
-            }
-        } else {
-            response.content = "No content in response";
-            response.success = false;
-        }
-    } catch (const nlohmann::json::exception& e) {
-        response.content = "Failed to parse response: " + std::string(e.what());
+    // SAX extraction pulls just content[0].text out of the body
+    // without materializing a DOM for large completions.
+    auto extracted = extractJsonStringField(http_response.body, {"content", 0, "text"});
+    if (extracted.found) {
+        response.content = extracted.value;
+    } else if (extracted.parse_error) {
+        response.content = "Failed to parse response";
+        response.success = false;
+    } else {
+        response.content = "No content in response";
         response.success = false;
     }
 
+    // The body is fully consumed; hand its capacity back for reuse.
+    BufferPool::shared().release(std::move(http_response.body));
+
     return response;
 }
 
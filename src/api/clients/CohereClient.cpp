@@ -1,5 +1,13 @@
 #include "CohereClient.h"
 #include "../base/ApiException.h"
+#include "../base/AsyncHttpClient.h"
+#include "../base/RateLimiter.h"
+#include "../base/BufferPool.h"
+#include "../base/ModelCatalog.h"
+#include "../base/ResponseCache.h"
+#include "../base/SseParser.h"
+#include "../base/JsonExtractor.h"
+#include "../base/Metrics.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -12,49 +20,169 @@ CohereClient::CohereClient(const config::ApiConfig& config)
     http_client_ = std::make_unique<HttpClient>();
     http_client_->setDefaultTimeout(config_.timeout);
     http_client_->setUserAgent("AI-CLI-Cohere/1.0");
+    http_client_->setMetricsLabel(getProviderName());
+
+    if (config_.rate_limit.requests_per_second > 0.0) {
+        RateLimiter::shared().configure(getProviderName(),
+                                        config_.rate_limit.requests_per_second,
+                                        config_.rate_limit.burst);
+    }
 
     if (config_.auth.token.empty()) {
         throw ConfigException("Cohere API key not found in environment variable: " + config_.auth.env_var);
     }
 
-    try {
-        testConnection();
-        connected_ = true;
-    } catch (const std::exception& e) {
-        std::cerr << "Warning: Failed to test Cohere connection: " << e.what() << std::endl;
-        connected_ = false;
+    // Built here once: the header set depends only on fixed configuration.
+    base_headers_.set("Content-Type", "application/json");
+    if (config_.auth.type == "bearer") {
+        base_headers_.set("Authorization", "Bearer " + config_.auth.token);
     }
+
+    // Connectivity is validated lazily: construction stays network-free and
+    // the first real request doubles as the probe.
 }
 
 ApiResponse CohereClient::sendMessage(const MessageRequest& request) {
-    if (!connected_) {
-        testConnection();
+    auto endpoint_url = buildEndpointUrl("chat");
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+
+    // Mapped contexts stream straight out of the page cache and skip the
+    // response cache: hashing the payload would force the very copy this
+    // path exists to avoid.
+    if (!request.context_file.empty()) {
+        try {
+            auto http_response = http_client_->post(endpoint_url, buildMappedPayload(request), headers);
+            if (http_response.success) {
+                connected_ = true;
+            }
+            return parseResponse(http_response);
+        } catch (const std::exception& e) {
+            throw ApiException("Cohere API request failed: " + std::string(e.what()));
+        }
     }
 
-    auto endpoint_url = buildEndpointUrl("chat");
-    auto headers = buildHeaders();
     auto payload = buildChatPayload(request);
 
+    // Identical payloads are answered from the shared response cache when it
+    // is enabled; a large share of batch traffic repeats prompts verbatim.
+    if (auto cached = ResponseCache::shared().lookup(getProviderName(), payload)) {
+        BufferPool::shared().release(std::move(payload));
+        return *cached;
+    }
+
     try {
         auto http_response = http_client_->post(endpoint_url, payload, headers);
-        return parseResponse(http_response);
+        if (http_response.success) {
+            connected_ = true;
+        }
+        auto api_response = parseResponse(http_response);
+        if (api_response.success) {
+            ResponseCache::shared().store(getProviderName(), payload, api_response);
+        }
+        BufferPool::shared().release(std::move(payload));
+        return api_response;
     } catch (const std::exception& e) {
         throw ApiException("Cohere API request failed: " + std::string(e.what()));
     }
 }
 
+ApiResponse CohereClient::sendMessageStream(const MessageRequest& request,
+                                            const StreamCallback& on_chunk) {
+    auto endpoint_url = buildEndpointUrl("chat");
+    HeaderMap headers = buildHeaders();
+    headers.set("Accept", "text/event-stream");
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    auto payload = buildChatPayload(request, true);
+
+    std::string content;
+    SseParser parser([&](const std::string& event) {
+        auto text = parseStreamEvent(event);
+        if (!text.empty()) {
+            content += text;
+            if (on_chunk) {
+                on_chunk(text);
+            }
+        }
+    });
+
+    try {
+        auto http_response = http_client_->postStream(endpoint_url, payload, headers,
+            [&](const char* data, size_t length) {
+                parser.feed(data, length);
+            });
+
+        if (http_response.success) {
+            connected_ = true;
+        }
+
+        ApiResponse response;
+        response.status_code = http_response.status_code;
+        response.headers = http_response.headers;
+        response.success = http_response.success;
+        response.error_message = http_response.error_message;
+        response.content = http_response.success ? content : http_response.body;
+        return response;
+    } catch (const std::exception& e) {
+        throw ApiException("Cohere API request failed: " + std::string(e.what()));
+    }
+}
+
+Task<ApiResponse> CohereClient::co_sendMessage(MessageRequest request) {
+    auto endpoint_url = buildEndpointUrl("chat");
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    std::string payload = buildChatPayload(request);
+
+    auto http_response = co_await http_client_->coPost(endpoint_url, payload, headers);
+    if (http_response.success) {
+        connected_ = true;
+    }
+    co_return parseResponse(http_response);
+}
+
 std::vector<std::string> CohereClient::getAvailableModels() {
-    std::vector<std::string> models = {
+    // Discovery goes through the shared TTL cache; the hardcoded
+    // list survives only as the fallback when every fetch fails.
+    static const std::vector<std::string> kFallbackModels = {
         "command",
         "command-r",
         "command-r-plus",
         "command-light"
     };
-    return models;
+    return ModelCatalog::shared().getModels(getProviderName(),
+                                            [this] { return fetchModels(); },
+                                            kFallbackModels);
+}
+
+std::vector<std::string> CohereClient::fetchModels() const {
+    auto it = config_.endpoints.endpoints.find("models");
+    if (it == config_.endpoints.endpoints.end()) {
+        return {};
+    }
+
+    try {
+        auto http_response = http_client_->get(config_.base_url + it->second, buildHeaders());
+        if (!http_response.success) {
+            return {};
+        }
+
+        std::vector<std::string> models;
+        auto json = nlohmann::json::parse(http_response.body);
+        for (const auto& item : json.value("models", nlohmann::json::array())) {
+            if (item.contains("name") && item["name"].is_string()) {
+                models.push_back(item["name"]);
+            }
+        }
+        return models;
+    } catch (const std::exception&) {
+        return {};
+    }
 }
 
 void CohereClient::setModel(const std::string& model) {
     current_model_ = model;
+    payload_template_.reset();
 }
 
 std::string CohereClient::getCurrentModel() const {
@@ -63,10 +191,12 @@ std::string CohereClient::getCurrentModel() const {
 
 void CohereClient::setMaxTokens(int max_tokens) {
     max_tokens_ = max_tokens;
+    payload_template_.reset();
 }
 
 void CohereClient::setTemperature(double temperature) {
     temperature_ = temperature;
+    payload_template_.reset();
 }
 
 bool CohereClient::isConnected() const {
@@ -79,7 +209,7 @@ std::string CohereClient::getProviderName() const {
 
 void CohereClient::testConnection() {
     auto endpoint_url = buildEndpointUrl("chat");
-    auto headers = buildHeaders();
+    const auto& headers = buildHeaders();
 
     // Send a minimal test request
     nlohmann::json test_payload = {
@@ -103,6 +233,10 @@ void CohereClient::testConnection() {
     }
 }
 
+std::map<std::string, std::string> CohereClient::getMetrics() const {
+    return MetricsRegistry::shared().providerMetrics(getProviderName());
+}
+
 std::map<std::string, std::string> CohereClient::getConnectionInfo() const {
     return {
         {"provider", getProviderName()},
@@ -122,23 +256,63 @@ std::string CohereClient::buildEndpointUrl(const std::string& endpoint) const {
     return config_.base_url + it->second;
 }
 
-std::map<std::string, std::string> CohereClient::buildHeaders() const {
-    std::map<std::string, std::string> headers;
-
-    headers["Content-Type"] = "application/json";
+const HeaderMap& CohereClient::buildHeaders() const {
+    return base_headers_;
+}
 
-    if (config_.auth.type == "bearer") {
-        headers["Authorization"] = "Bearer " + config_.auth.token;
+std::string CohereClient::buildChatPayload(const MessageRequest& request, bool stream) const {
+    // Batch traffic repeats the same settings with only the user message
+    // substituted; serialize the invariant envelope once and splice the
+    // escaped message into a pooled buffer instead of rebuilding the DOM.
+    bool template_eligible = !stream && request.model.empty() &&
+                             request.max_tokens <= 0 && request.temperature < 0 &&
+                             request.stop_sequences.empty() && request.history.empty() &&
+                             request.serialized_messages.empty() &&
+                             request.context_file.empty();
+    if (template_eligible) {
+        if (!payload_template_.compiled()) {
+            MessageRequest probe;
+            probe.message = std::string(PayloadTemplate::kSlot);
+            probe.max_tokens = 0;
+            probe.temperature = -1.0;
+            payload_template_.compile(buildChatPayloadDom(probe, false));
+        }
+        if (payload_template_.compiled()) {
+            std::string payload = BufferPool::shared().acquire();
+            payload_template_.render(request.message, payload);
+            return payload;
+        }
     }
 
-    return headers;
+    return buildChatPayloadDom(request, stream);
 }
 
-std::string CohereClient::buildChatPayload(const MessageRequest& request) const {
+std::string CohereClient::buildChatPayloadDom(const MessageRequest& request, bool stream) const {
     nlohmann::json payload;
 
+    // Fallback used by the paths that materialize the payload (streaming,
+    // coroutines, templates): the context is appended to the message here;
+    // sendMessage streams it zero-copy instead.
+    std::string message = request.message;
+    if (!request.context_file.empty()) {
+        auto context = MappedFile::open(request.context_file);
+        message.append(context->data(), context->size());
+    }
+
     payload["model"] = request.model.empty() ? current_model_ : request.model;
-    payload["message"] = request.message;
+    payload["message"] = message;
+
+    // Cohere takes prior turns as chat_history with USER/CHATBOT roles.
+    if (!request.history.empty()) {
+        auto chat_history = nlohmann::json::array();
+        for (const auto& turn : request.history) {
+            chat_history.push_back({
+                {"role", turn.role == "assistant" ? "CHATBOT" : "USER"},
+                {"message", turn.content}
+            });
+        }
+        payload["chat_history"] = std::move(chat_history);
+    }
 
     if (request.max_tokens > 0) {
         payload["max_tokens"] = request.max_tokens;
@@ -156,10 +330,56 @@ std::string CohereClient::buildChatPayload(const MessageRequest& request) const
         payload["stop_sequences"] = request.stop_sequences;
     }
 
+    if (stream) {
+        payload["stream"] = true;
+    }
+
     return payload.dump();
 }
 
-ApiResponse CohereClient::parseResponse(const HttpResponse& http_response) const {
+std::shared_ptr<UploadBody> CohereClient::buildMappedPayload(const MessageRequest& request) const {
+    // Serialize the envelope with the slot sentinel appended to the user
+    // message, then splice the mapped document through the slot position: its
+    // bytes flow from the page cache into the transfer with JSON escaping
+    // applied on the fly, never materialized in a payload string.
+    MessageRequest probe = request;
+    probe.context_file.clear();
+    probe.message += PayloadTemplate::kSlot;
+    std::string serialized = buildChatPayloadDom(probe, false);
+    auto slot = serialized.find(PayloadTemplate::kSlot);
+
+    auto body = std::make_shared<UploadBody>();
+    if (slot == std::string::npos) {
+        // Pre-serialized transcripts embed the message elsewhere; fall back
+        // to the materialized payload with the context appended.
+        body->append(buildChatPayloadDom(request, false));
+        return body;
+    }
+
+    body->append(serialized.substr(0, slot));
+    body->appendJsonEscaped(MappedFile::open(request.context_file));
+    body->append(serialized.substr(slot + PayloadTemplate::kSlot.size()));
+    return body;
+}
+
+std::string CohereClient::parseStreamEvent(const std::string& event) const {
+    // Cohere tags each streamed event with an event_type; text arrives in
+    // text-generation events as {"event_type":"text-generation","text":...}.
+    try {
+        auto json_event = nlohmann::json::parse(event);
+
+        if (json_event.contains("event_type") && json_event["event_type"] == "text-generation" &&
+            json_event.contains("text") && json_event["text"].is_string()) {
+            return json_event["text"];
+        }
+    } catch (const nlohmann::json::exception&) {
+        // Ignore malformed events.
+    }
+
+    return {};
+}
+
+ApiResponse CohereClient::parseResponse(HttpResponse& http_response) const {
     ApiResponse response;
     response.status_code = http_response.status_code;
     response.headers = http_response.headers;
@@ -167,24 +387,26 @@ ApiResponse CohereClient::parseResponse(const HttpResponse& http_response) const
     response.error_message = http_response.error_message;
 
     if (!http_response.success) {
-        response.content = http_response.body;
+        response.content = std::move(http_response.body);
         return response;
     }
 
-    try {
-        auto json_response = nlohmann::json::parse(http_response.body);
-
-        if (json_response.contains("text") && json_response["text"].is_string()) {
-            response.content = json_response["text"];
-        } else {
-            response.content = "No content in response";
-            response.success = false;
-        }
-    } catch (const nlohmann::json::exception& e) {
-        response.content = "Failed to parse response: " + std::string(e.what());
+    // SAX extraction pulls just the top-level text field out of the body
+    // without materializing a DOM for large completions.
+    auto extracted = extractJsonStringField(http_response.body, {"text"});
+    if (extracted.found) {
+        response.content = extracted.value;
+    } else if (extracted.parse_error) {
+        response.content = "Failed to parse response";
+        response.success = false;
+    } else {
+        response.content = "No content in response";
         response.success = false;
     }
 
+    // The body is fully consumed; hand its capacity back for reuse.
+    BufferPool::shared().release(std::move(http_response.body));
+
     return response;
 }
 
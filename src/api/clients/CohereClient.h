@@ -2,17 +2,26 @@
 
 #include "../base/IApiClient.h"
 #include "../base/HttpClient.h"
+#include "../base/PayloadTemplate.h"
+#include "../base/UploadBody.h"
 #include "../../config/ApiConfig.h"
 #include <memory>
+#include <string_view>
 
 namespace api {
 
 class CohereClient : public IApiClient {
 public:
+    // Configuration key this client is registered under; see ProviderRegistry.h.
+    static constexpr std::string_view kProviderId = "cohere";
+
     explicit CohereClient(const config::ApiConfig& config);
     ~CohereClient() override = default;
 
     ApiResponse sendMessage(const MessageRequest& request) override;
+    ApiResponse sendMessageStream(const MessageRequest& request,
+                                  const StreamCallback& on_chunk) override;
+    Task<ApiResponse> co_sendMessage(MessageRequest request) override;
     std::vector<std::string> getAvailableModels() override;
     void setModel(const std::string& model) override;
     std::string getCurrentModel() const override;
@@ -22,6 +31,7 @@ public:
     std::string getProviderName() const override;
     void testConnection() override;
     std::map<std::string, std::string> getConnectionInfo() const override;
+    std::map<std::string, std::string> getMetrics() const override;
 
 private:
     config::ApiConfig config_;
@@ -30,11 +40,19 @@ private:
     int max_tokens_;
     double temperature_;
     bool connected_;
+    HeaderMap base_headers_;
+    // Compiled lazily on the first eligible request; like the rest of the
+    // client's request state, it serves one request at a time.
+    mutable PayloadTemplate payload_template_;
 
+    std::vector<std::string> fetchModels() const;
     std::string buildEndpointUrl(const std::string& endpoint) const;
-    std::map<std::string, std::string> buildHeaders() const;
-    std::string buildChatPayload(const MessageRequest& request) const;
-    ApiResponse parseResponse(const HttpResponse& http_response) const;
+    const HeaderMap& buildHeaders() const;
+    std::string buildChatPayload(const MessageRequest& request, bool stream = false) const;
+    std::string buildChatPayloadDom(const MessageRequest& request, bool stream) const;
+    std::shared_ptr<UploadBody> buildMappedPayload(const MessageRequest& request) const;
+    ApiResponse parseResponse(HttpResponse& http_response) const;
+    std::string parseStreamEvent(const std::string& event) const;
 };
 
 } // namespace api
\ No newline at end of file
@@ -1,5 +1,13 @@
 #include "GeminiClient.h"
 #include "../base/ApiException.h"
+#include "../base/AsyncHttpClient.h"
+#include "../base/RateLimiter.h"
+#include "../base/BufferPool.h"
+#include "../base/ModelCatalog.h"
+#include "../base/ResponseCache.h"
+#include "../base/SseParser.h"
+#include "../base/JsonExtractor.h"
+#include "../base/Metrics.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -12,48 +20,171 @@ GeminiClient::GeminiClient(const config::ApiConfig& config)
     http_client_ = std::make_unique<HttpClient>();
     http_client_->setDefaultTimeout(config_.timeout);
     http_client_->setUserAgent("AI-CLI-Gemini/1.0");
+    http_client_->setMetricsLabel(getProviderName());
+
+    if (config_.rate_limit.requests_per_second > 0.0) {
+        RateLimiter::shared().configure(getProviderName(),
+                                        config_.rate_limit.requests_per_second,
+                                        config_.rate_limit.burst);
+    }
 
     if (config_.auth.token.empty()) {
         throw ConfigException("Gemini API key not found in environment variable: " + config_.auth.env_var);
     }
 
-    try {
-        testConnection();
-        connected_ = true;
-    } catch (const std::exception& e) {
-        std::cerr << "Warning: Failed to test Gemini connection: " << e.what() << std::endl;
-        connected_ = false;
-    }
+    // Built here once: authentication travels in the URL, so only the
+    // content type is ever sent.
+    base_headers_.set("Content-Type", "application/json");
+
+    // Connectivity is validated lazily: construction stays network-free and
+    // the first real request doubles as the probe.
 }
 
 ApiResponse GeminiClient::sendMessage(const MessageRequest& request) {
-    if (!connected_) {
-        testConnection();
-    }
-
     auto endpoint_url = buildEndpointUrl("generate");
     endpoint_url = addApiKeyToUrl(endpoint_url);
-    auto headers = buildHeaders();
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+
+    // Mapped contexts stream straight out of the page cache and skip the
+    // response cache: hashing the payload would force the very copy this
+    // path exists to avoid.
+    if (!request.context_file.empty()) {
+        try {
+            auto http_response = http_client_->post(endpoint_url, buildMappedPayload(request), headers);
+            if (http_response.success) {
+                connected_ = true;
+            }
+            return parseResponse(http_response);
+        } catch (const std::exception& e) {
+            throw ApiException("Gemini API request failed: " + std::string(e.what()));
+        }
+    }
+
     auto payload = buildGeneratePayload(request);
 
+    // Identical payloads are answered from the shared response cache when it
+    // is enabled; a large share of batch traffic repeats prompts verbatim.
+    if (auto cached = ResponseCache::shared().lookup(getProviderName(), payload)) {
+        BufferPool::shared().release(std::move(payload));
+        return *cached;
+    }
+
     try {
         auto http_response = http_client_->post(endpoint_url, payload, headers);
-        return parseResponse(http_response);
+        if (http_response.success) {
+            connected_ = true;
+        }
+        auto api_response = parseResponse(http_response);
+        if (api_response.success) {
+            ResponseCache::shared().store(getProviderName(), payload, api_response);
+        }
+        BufferPool::shared().release(std::move(payload));
+        return api_response;
     } catch (const std::exception& e) {
         throw ApiException("Gemini API request failed: " + std::string(e.what()));
     }
 }
 
+ApiResponse GeminiClient::sendMessageStream(const MessageRequest& request,
+                                            const StreamCallback& on_chunk) {
+    auto endpoint_url = addApiKeyToUrl(buildStreamUrl());
+    HeaderMap headers = buildHeaders();
+    headers.set("Accept", "text/event-stream");
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    std::string payload = buildGeneratePayload(request);
+
+    std::string content;
+    SseParser parser([&](const std::string& event) {
+        auto text = parseStreamEvent(event);
+        if (!text.empty()) {
+            content += text;
+            if (on_chunk) {
+                on_chunk(text);
+            }
+        }
+    });
+
+    try {
+        auto http_response = http_client_->postStream(endpoint_url, payload, headers,
+            [&](const char* data, size_t length) {
+                parser.feed(data, length);
+            });
+
+        if (http_response.success) {
+            connected_ = true;
+        }
+
+        ApiResponse response;
+        response.status_code = http_response.status_code;
+        response.headers = http_response.headers;
+        response.success = http_response.success;
+        response.error_message = http_response.error_message;
+        response.content = http_response.success ? content : http_response.body;
+        return response;
+    } catch (const std::exception& e) {
+        throw ApiException("Gemini API request failed: " + std::string(e.what()));
+    }
+}
+
+Task<ApiResponse> GeminiClient::co_sendMessage(MessageRequest request) {
+    auto endpoint_url = buildEndpointUrl("generate");
+    endpoint_url = addApiKeyToUrl(endpoint_url);
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    auto payload = buildGeneratePayload(request);
+
+    auto http_response = co_await http_client_->coPost(endpoint_url, payload, headers);
+    if (http_response.success) {
+        connected_ = true;
+    }
+    co_return parseResponse(http_response);
+}
+
 std::vector<std::string> GeminiClient::getAvailableModels() {
-    std::vector<std::string> models = {
+    // Discovery goes through the shared TTL cache; the hardcoded
+    // list survives only as the fallback when every fetch fails.
+    static const std::vector<std::string> kFallbackModels = {
         "gemini-pro",
         "gemini-pro-vision"
     };
-    return models;
+    return ModelCatalog::shared().getModels(getProviderName(),
+                                            [this] { return fetchModels(); },
+                                            kFallbackModels);
+}
+
+std::vector<std::string> GeminiClient::fetchModels() const {
+    auto it = config_.endpoints.endpoints.find("models");
+    if (it == config_.endpoints.endpoints.end()) {
+        return {};
+    }
+
+    try {
+        auto url = addApiKeyToUrl(config_.base_url + it->second);
+        auto http_response = http_client_->get(url, buildHeaders());
+        if (!http_response.success) {
+            return {};
+        }
+
+        std::vector<std::string> models;
+        auto json = nlohmann::json::parse(http_response.body);
+        for (const auto& item : json.value("models", nlohmann::json::array())) {
+            if (item.contains("name") && item["name"].is_string()) {
+                // Names arrive as "models/gemini-pro"; keep the bare id.
+                std::string name = item["name"];
+                auto slash = name.rfind('/');
+                models.push_back(slash == std::string::npos ? name : name.substr(slash + 1));
+            }
+        }
+        return models;
+    } catch (const std::exception&) {
+        return {};
+    }
 }
 
 void GeminiClient::setModel(const std::string& model) {
     current_model_ = model;
+    payload_template_.reset();
 }
 
 std::string GeminiClient::getCurrentModel() const {
@@ -62,10 +193,12 @@ std::string GeminiClient::getCurrentModel() const {
 
 void GeminiClient::setMaxTokens(int max_tokens) {
     max_tokens_ = max_tokens;
+    payload_template_.reset();
 }
 
 void GeminiClient::setTemperature(double temperature) {
     temperature_ = temperature;
+    payload_template_.reset();
 }
 
 bool GeminiClient::isConnected() const {
@@ -79,7 +212,7 @@ std::string GeminiClient::getProviderName() const {
 void GeminiClient::testConnection() {
     auto endpoint_url = buildEndpointUrl("generate");
     endpoint_url = addApiKeyToUrl(endpoint_url);
-    auto headers = buildHeaders();
+    const auto& headers = buildHeaders();
 
     // Send a minimal test request
     nlohmann::json test_payload = {
@@ -105,6 +238,10 @@ void GeminiClient::testConnection() {
     }
 }
 
+std::map<std::string, std::string> GeminiClient::getMetrics() const {
+    return MetricsRegistry::shared().providerMetrics(getProviderName());
+}
+
 std::map<std::string, std::string> GeminiClient::getConnectionInfo() const {
     return {
         {"provider", getProviderName()},
@@ -124,21 +261,71 @@ std::string GeminiClient::buildEndpointUrl(const std::string& endpoint) const {
     return config_.base_url + it->second;
 }
 
-std::map<std::string, std::string> GeminiClient::buildHeaders() const {
-    std::map<std::string, std::string> headers;
-    headers["Content-Type"] = "application/json";
-    return headers;
+const HeaderMap& GeminiClient::buildHeaders() const {
+    return base_headers_;
 }
 
 std::string GeminiClient::buildGeneratePayload(const MessageRequest& request) const {
+    // Batch traffic repeats the same settings with only the user message
+    // substituted; serialize the invariant envelope once and splice the
+    // escaped message into a pooled buffer instead of rebuilding the DOM.
+    bool template_eligible = request.model.empty() &&
+                             request.max_tokens <= 0 && request.temperature < 0 &&
+                             request.stop_sequences.empty() && request.history.empty() &&
+                             request.serialized_messages.empty() &&
+                             request.context_file.empty();
+    if (template_eligible) {
+        if (!payload_template_.compiled()) {
+            MessageRequest probe;
+            probe.message = std::string(PayloadTemplate::kSlot);
+            probe.max_tokens = 0;
+            probe.temperature = -1.0;
+            payload_template_.compile(buildGeneratePayloadDom(probe));
+        }
+        if (payload_template_.compiled()) {
+            std::string payload = BufferPool::shared().acquire();
+            payload_template_.render(request.message, payload);
+            return payload;
+        }
+    }
+
+    return buildGeneratePayloadDom(request);
+}
+
+std::string GeminiClient::buildGeneratePayloadDom(const MessageRequest& request) const {
     nlohmann::json payload;
 
-    // Gemini uses "contents" array with "parts"
-    payload["contents"] = nlohmann::json::array({
-        {{"parts", nlohmann::json::array({
-            {{"text", request.message}}
-        })}}
-    });
+    // Fallback used by the paths that materialize the payload (streaming,
+    // coroutines, templates): the context is appended to the message here;
+    // sendMessage streams it zero-copy instead.
+    std::string message = request.message;
+    if (!request.context_file.empty()) {
+        auto context = MappedFile::open(request.context_file);
+        message.append(context->data(), context->size());
+    }
+
+    // Gemini uses "contents" array with "parts". Multi-turn requests carry
+    // explicit roles; Gemini names the assistant side "model".
+    if (request.history.empty()) {
+        payload["contents"] = nlohmann::json::array({
+            {{"parts", nlohmann::json::array({
+                {{"text", message}}
+            })}}
+        });
+    } else {
+        auto contents = nlohmann::json::array();
+        for (const auto& turn : request.history) {
+            contents.push_back({
+                {"role", turn.role == "assistant" ? "model" : "user"},
+                {"parts", nlohmann::json::array({{{"text", turn.content}}})}
+            });
+        }
+        contents.push_back({
+            {"role", "user"},
+            {"parts", nlohmann::json::array({{{"text", message}}})}
+        });
+        payload["contents"] = std::move(contents);
+    }
 
     // Generation config
     nlohmann::json generation_config;
@@ -166,7 +353,32 @@ std::string GeminiClient::buildGeneratePayload(const MessageRequest& request) co
     return payload.dump();
 }
 
-ApiResponse GeminiClient::parseResponse(const HttpResponse& http_response) const {
+std::shared_ptr<UploadBody> GeminiClient::buildMappedPayload(const MessageRequest& request) const {
+    // Serialize the envelope with the slot sentinel appended to the user
+    // message, then splice the mapped document through the slot position: its
+    // bytes flow from the page cache into the transfer with JSON escaping
+    // applied on the fly, never materialized in a payload string.
+    MessageRequest probe = request;
+    probe.context_file.clear();
+    probe.message += PayloadTemplate::kSlot;
+    std::string serialized = buildGeneratePayloadDom(probe);
+    auto slot = serialized.find(PayloadTemplate::kSlot);
+
+    auto body = std::make_shared<UploadBody>();
+    if (slot == std::string::npos) {
+        // Pre-serialized transcripts embed the message elsewhere; fall back
+        // to the materialized payload with the context appended.
+        body->append(buildGeneratePayloadDom(request));
+        return body;
+    }
+
+    body->append(serialized.substr(0, slot));
+    body->appendJsonEscaped(MappedFile::open(request.context_file));
+    body->append(serialized.substr(slot + PayloadTemplate::kSlot.size()));
+    return body;
+}
+
+ApiResponse GeminiClient::parseResponse(HttpResponse& http_response) const {
     ApiResponse response;
     response.status_code = http_response.status_code;
     response.headers = http_response.headers;
@@ -174,33 +386,67 @@ ApiResponse GeminiClient::parseResponse(const HttpResponse& http_response) const
     response.error_message = http_response.error_message;
 
     if (!http_response.success) {
-        response.content = http_response.body;
+        response.content = std::move(http_response.body);
         return response;
     }
 
+    // SAX extraction pulls just candidates[0].content.parts[0].text out of the body
+    // without materializing a DOM for large completions.
+    auto extracted = extractJsonStringField(http_response.body, {"candidates", 0, "content", "parts", 0, "text"});
+    if (extracted.found) {
+        response.content = extracted.value;
+    } else if (extracted.parse_error) {
+        response.content = "Failed to parse response";
+        response.success = false;
+    } else {
+        response.content = "No content in response";
+        response.success = false;
+    }
+
+    // The body is fully consumed; hand its capacity back for reuse.
+    BufferPool::shared().release(std::move(http_response.body));
+
+    return response;
+}
+
+std::string GeminiClient::parseStreamEvent(const std::string& event) const {
+    // Each SSE event is a full GenerateContentResponse carrying the next
+    // slice of text under candidates[0].content.parts[0].text.
     try {
-        auto json_response = nlohmann::json::parse(http_response.body);
+        auto json_event = nlohmann::json::parse(event);
 
-        if (json_response.contains("candidates") && json_response["candidates"].is_array() &&
-            !json_response["candidates"].empty()) {
-            auto first_candidate = json_response["candidates"][0];
+        if (json_event.contains("candidates") && json_event["candidates"].is_array() &&
+            !json_event["candidates"].empty()) {
+            auto first_candidate = json_event["candidates"][0];
             if (first_candidate.contains("content") && first_candidate["content"].contains("parts") &&
-                first_candidate["content"]["parts"].is_array() && !first_candidate["content"]["parts"].empty()) {
+                first_candidate["content"]["parts"].is_array() &&
+                !first_candidate["content"]["parts"].empty()) {
                 auto first_part = first_candidate["content"]["parts"][0];
                 if (first_part.contains("text") && first_part["text"].is_string()) {
-                    response.content = first_part["text"];
+                    return first_part["text"];
                 }
             }
-        } else {
-            response.content = "No content in response";
-            response.success = false;
         }
-    } catch (const nlohmann::json::exception& e) {
-        response.content = "Failed to parse response: " + std::string(e.what());
-        response.success = false;
+    } catch (const nlohmann::json::exception&) {
+        // Ignore malformed events.
     }
 
-    return response;
+    return {};
+}
+
+std::string GeminiClient::buildStreamUrl() const {
+    // Gemini streams through the streamGenerateContent method of the same
+    // model resource, with alt=sse selecting SSE framing.
+    auto url = buildEndpointUrl("generate");
+
+    static const std::string generate_method = ":generateContent";
+    auto pos = url.find(generate_method);
+    if (pos != std::string::npos) {
+        url.replace(pos, generate_method.size(), ":streamGenerateContent");
+    }
+
+    char separator = (url.find('?') != std::string::npos) ? '&' : '?';
+    return url + separator + "alt=sse";
 }
 
 std::string GeminiClient::addApiKeyToUrl(const std::string& url) const {
@@ -1,5 +1,13 @@
 #include "OpenAIClient.h"
 #include "../base/ApiException.h"
+#include "../base/AsyncHttpClient.h"
+#include "../base/RateLimiter.h"
+#include "../base/BufferPool.h"
+#include "../base/ModelCatalog.h"
+#include "../base/ResponseCache.h"
+#include "../base/SseParser.h"
+#include "../base/JsonExtractor.h"
+#include "../base/Metrics.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 
@@ -12,50 +20,170 @@ OpenAIClient::OpenAIClient(const config::ApiConfig& config)
     http_client_ = std::make_unique<HttpClient>();
     http_client_->setDefaultTimeout(config_.timeout);
     http_client_->setUserAgent("AI-CLI-OpenAI/1.0");
+    http_client_->setMetricsLabel(getProviderName());
+
+    if (config_.rate_limit.requests_per_second > 0.0) {
+        RateLimiter::shared().configure(getProviderName(),
+                                        config_.rate_limit.requests_per_second,
+                                        config_.rate_limit.burst);
+    }
 
     if (config_.auth.token.empty()) {
         throw ConfigException("OpenAI API key not found in environment variable: " + config_.auth.env_var);
     }
 
-    try {
-        testConnection();
-        connected_ = true;
-    } catch (const std::exception& e) {
-        std::cerr << "Warning: Failed to test OpenAI connection: " << e.what() << std::endl;
-        connected_ = false;
+    // Built here once: the header set depends only on fixed configuration.
+    base_headers_.set("Content-Type", "application/json");
+    if (config_.auth.type == "bearer") {
+        base_headers_.set("Authorization", "Bearer " + config_.auth.token);
     }
+
+    // Connectivity is validated lazily: construction stays network-free and
+    // the first real request doubles as the probe.
 }
 
 ApiResponse OpenAIClient::sendMessage(const MessageRequest& request) {
-    if (!connected_) {
-        testConnection();
+    auto endpoint_url = buildEndpointUrl("chat");
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+
+    // Mapped contexts stream straight out of the page cache and skip the
+    // response cache: hashing the payload would force the very copy this
+    // path exists to avoid.
+    if (!request.context_file.empty()) {
+        try {
+            auto http_response = http_client_->post(endpoint_url, buildMappedPayload(request), headers);
+            if (http_response.success) {
+                connected_ = true;
+            }
+            return parseResponse(http_response);
+        } catch (const std::exception& e) {
+            throw ApiException("OpenAI API request failed: " + std::string(e.what()));
+        }
     }
 
-    auto endpoint_url = buildEndpointUrl("chat");
-    auto headers = buildHeaders();
     auto payload = buildChatPayload(request);
 
+    // Identical payloads are answered from the shared response cache when it
+    // is enabled; a large share of batch traffic repeats prompts verbatim.
+    if (auto cached = ResponseCache::shared().lookup(getProviderName(), payload)) {
+        BufferPool::shared().release(std::move(payload));
+        return *cached;
+    }
+
     try {
         auto http_response = http_client_->post(endpoint_url, payload, headers);
-        return parseResponse(http_response);
+        if (http_response.success) {
+            connected_ = true;
+        }
+        auto api_response = parseResponse(http_response);
+        if (api_response.success) {
+            ResponseCache::shared().store(getProviderName(), payload, api_response);
+        }
+        BufferPool::shared().release(std::move(payload));
+        return api_response;
     } catch (const std::exception& e) {
         throw ApiException("OpenAI API request failed: " + std::string(e.what()));
     }
 }
 
+ApiResponse OpenAIClient::sendMessageStream(const MessageRequest& request,
+                                            const StreamCallback& on_chunk) {
+    auto endpoint_url = buildEndpointUrl("chat");
+    HeaderMap headers = buildHeaders();
+    headers.set("Accept", "text/event-stream");
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    auto payload = buildChatPayload(request, true);
+
+    std::string content;
+    SseParser parser([&](const std::string& event) {
+        auto text = parseStreamEvent(event);
+        if (!text.empty()) {
+            content += text;
+            if (on_chunk) {
+                on_chunk(text);
+            }
+        }
+    });
+
+    try {
+        auto http_response = http_client_->postStream(endpoint_url, payload, headers,
+            [&](const char* data, size_t length) {
+                parser.feed(data, length);
+            });
+
+        if (http_response.success) {
+            connected_ = true;
+        }
+
+        ApiResponse response;
+        response.status_code = http_response.status_code;
+        response.headers = http_response.headers;
+        response.success = http_response.success;
+        response.error_message = http_response.error_message;
+        response.content = http_response.success ? content : http_response.body;
+        return response;
+    } catch (const std::exception& e) {
+        throw ApiException("OpenAI API request failed: " + std::string(e.what()));
+    }
+}
+
+Task<ApiResponse> OpenAIClient::co_sendMessage(MessageRequest request) {
+    auto endpoint_url = buildEndpointUrl("chat");
+    const auto& headers = buildHeaders();
+    http_client_->setModelLabel(request.model.empty() ? current_model_ : request.model);
+    std::string payload = buildChatPayload(request);
+
+    auto http_response = co_await http_client_->coPost(endpoint_url, payload, headers);
+    if (http_response.success) {
+        connected_ = true;
+    }
+    co_return parseResponse(http_response);
+}
+
 std::vector<std::string> OpenAIClient::getAvailableModels() {
-    std::vector<std::string> models = {
+    // Discovery goes through the shared TTL cache; the hardcoded
+    // list survives only as the fallback when every fetch fails.
+    static const std::vector<std::string> kFallbackModels = {
         "gpt-4",
         "gpt-4-turbo",
         "gpt-4-turbo-preview",
         "gpt-3.5-turbo",
         "gpt-3.5-turbo-16k"
     };
-    return models;
+    return ModelCatalog::shared().getModels(getProviderName(),
+                                            [this] { return fetchModels(); },
+                                            kFallbackModels);
+}
+
+std::vector<std::string> OpenAIClient::fetchModels() const {
+    auto it = config_.endpoints.endpoints.find("models");
+    if (it == config_.endpoints.endpoints.end()) {
+        return {};
+    }
+
+    try {
+        auto http_response = http_client_->get(config_.base_url + it->second, buildHeaders());
+        if (!http_response.success) {
+            return {};
+        }
+
+        std::vector<std::string> models;
+        auto json = nlohmann::json::parse(http_response.body);
+        for (const auto& item : json.value("data", nlohmann::json::array())) {
+            if (item.contains("id") && item["id"].is_string()) {
+                models.push_back(item["id"]);
+            }
+        }
+        return models;
+    } catch (const std::exception&) {
+        return {};
+    }
 }
 
 void OpenAIClient::setModel(const std::string& model) {
     current_model_ = model;
+    payload_template_.reset();
 }
 
 std::string OpenAIClient::getCurrentModel() const {
@@ -64,10 +192,12 @@ std::string OpenAIClient::getCurrentModel() const {
 
 void OpenAIClient::setMaxTokens(int max_tokens) {
     max_tokens_ = max_tokens;
+    payload_template_.reset();
 }
 
 void OpenAIClient::setTemperature(double temperature) {
     temperature_ = temperature;
+    payload_template_.reset();
 }
 
 bool OpenAIClient::isConnected() const {
@@ -80,7 +210,7 @@ std::string OpenAIClient::getProviderName() const {
 
 void OpenAIClient::testConnection() {
     auto endpoint_url = buildEndpointUrl("models");
-    auto headers = buildHeaders();
+    const auto& headers = buildHeaders();
 
     try {
         auto http_response = http_client_->get(endpoint_url, headers);
@@ -97,6 +227,10 @@ void OpenAIClient::testConnection() {
     }
 }
 
+std::map<std::string, std::string> OpenAIClient::getMetrics() const {
+    return MetricsRegistry::shared().providerMetrics(getProviderName());
+}
+
 std::map<std::string, std::string> OpenAIClient::getConnectionInfo() const {
     return {
         {"provider", getProviderName()},
@@ -116,21 +250,49 @@ std::string OpenAIClient::buildEndpointUrl(const std::string& endpoint) const {
     return config_.base_url + it->second;
 }
 
-std::map<std::string, std::string> OpenAIClient::buildHeaders() const {
-    std::map<std::string, std::string> headers;
-
-    headers["Content-Type"] = "application/json";
+const HeaderMap& OpenAIClient::buildHeaders() const {
+    return base_headers_;
+}
 
-    if (config_.auth.type == "bearer") {
-        headers["Authorization"] = "Bearer " + config_.auth.token;
+std::string OpenAIClient::buildChatPayload(const MessageRequest& request, bool stream) const {
+    // Batch traffic repeats the same settings with only the user message
+    // substituted; serialize the invariant envelope once and splice the
+    // escaped message into a pooled buffer instead of rebuilding the DOM.
+    bool template_eligible = !stream && request.model.empty() &&
+                             request.max_tokens <= 0 && request.temperature < 0 &&
+                             request.stop_sequences.empty() && request.history.empty() &&
+                             request.serialized_messages.empty() &&
+                             request.context_file.empty();
+    if (template_eligible) {
+        if (!payload_template_.compiled()) {
+            MessageRequest probe;
+            probe.message = std::string(PayloadTemplate::kSlot);
+            probe.max_tokens = 0;
+            probe.temperature = -1.0;
+            payload_template_.compile(buildChatPayloadDom(probe, false));
+        }
+        if (payload_template_.compiled()) {
+            std::string payload = BufferPool::shared().acquire();
+            payload_template_.render(request.message, payload);
+            return payload;
+        }
     }
 
-    return headers;
+    return buildChatPayloadDom(request, stream);
 }
 
-std::string OpenAIClient::buildChatPayload(const MessageRequest& request) const {
+std::string OpenAIClient::buildChatPayloadDom(const MessageRequest& request, bool stream) const {
     nlohmann::json payload;
 
+    // Fallback used by the paths that materialize the payload (streaming,
+    // coroutines, templates): the context is appended to the message here;
+    // sendMessage streams it zero-copy instead.
+    std::string message = request.message;
+    if (!request.context_file.empty()) {
+        auto context = MappedFile::open(request.context_file);
+        message.append(context->data(), context->size());
+    }
+
     payload["model"] = request.model.empty() ? current_model_ : request.model;
 
     if (request.max_tokens > 0) {
@@ -149,14 +311,79 @@ std::string OpenAIClient::buildChatPayload(const MessageRequest& request) const
         payload["stop"] = request.stop_sequences;
     }
 
-    payload["messages"] = nlohmann::json::array({
-        {{"role", "user"}, {"content", request.message}}
-    });
+    if (stream) {
+        payload["stream"] = true;
+    }
+
+    // A pre-serialized transcript (from Conversation's incremental cache) is
+    // spliced in verbatim; prior turns were serialized once when added.
+    if (!request.serialized_messages.empty()) {
+        std::string out = payload.dump();
+        out.insert(out.size() - 1, ",\"messages\":" + request.serialized_messages);
+        return out;
+    }
+
+    auto messages = nlohmann::json::array();
+    for (const auto& turn : request.history) {
+        messages.push_back({{"role", turn.role}, {"content", turn.content}});
+    }
+    messages.push_back({{"role", "user"}, {"content", message}});
+    payload["messages"] = std::move(messages);
 
     return payload.dump();
 }
 
-ApiResponse OpenAIClient::parseResponse(const HttpResponse& http_response) const {
+std::shared_ptr<UploadBody> OpenAIClient::buildMappedPayload(const MessageRequest& request) const {
+    // Serialize the envelope with the slot sentinel appended to the user
+    // message, then splice the mapped document through the slot position: its
+    // bytes flow from the page cache into the transfer with JSON escaping
+    // applied on the fly, never materialized in a payload string.
+    MessageRequest probe = request;
+    probe.context_file.clear();
+    probe.message += PayloadTemplate::kSlot;
+    std::string serialized = buildChatPayloadDom(probe, false);
+    auto slot = serialized.find(PayloadTemplate::kSlot);
+
+    auto body = std::make_shared<UploadBody>();
+    if (slot == std::string::npos) {
+        // Pre-serialized transcripts embed the message elsewhere; fall back
+        // to the materialized payload with the context appended.
+        body->append(buildChatPayloadDom(request, false));
+        return body;
+    }
+
+    body->append(serialized.substr(0, slot));
+    body->appendJsonEscaped(MappedFile::open(request.context_file));
+    body->append(serialized.substr(slot + PayloadTemplate::kSlot.size()));
+    return body;
+}
+
+std::string OpenAIClient::parseStreamEvent(const std::string& event) const {
+    // OpenAI streams chat completion chunks with the delta under
+    // choices[0].delta.content and terminates the stream with "[DONE]".
+    if (event == "[DONE]") {
+        return {};
+    }
+
+    try {
+        auto json_event = nlohmann::json::parse(event);
+
+        if (json_event.contains("choices") && json_event["choices"].is_array() &&
+            !json_event["choices"].empty()) {
+            auto first_choice = json_event["choices"][0];
+            if (first_choice.contains("delta") && first_choice["delta"].contains("content") &&
+                first_choice["delta"]["content"].is_string()) {
+                return first_choice["delta"]["content"];
+            }
+        }
+    } catch (const nlohmann::json::exception&) {
+        // Ignore malformed events.
+    }
+
+    return {};
+}
+
+ApiResponse OpenAIClient::parseResponse(HttpResponse& http_response) const {
     ApiResponse response;
     response.status_code = http_response.status_code;
     response.headers = http_response.headers;
@@ -164,28 +391,26 @@ ApiResponse OpenAIClient::parseResponse(const HttpResponse& http_response) const
     response.error_message = http_response.error_message;
 
     if (!http_response.success) {
-        response.content = http_response.body;
+        response.content = std::move(http_response.body);
         return response;
     }
 
-    try {
-        auto json_response = nlohmann::json::parse(http_response.body);
-
-        if (json_response.contains("choices") && json_response["choices"].is_array() &&
-            !json_response["choices"].empty()) {
-            auto first_choice = json_response["choices"][0];
-            if (first_choice.contains("message") && first_choice["message"].contains("content")) {
-                response.content = first_choice["message"]["content"];
-            }
-        } else {
-            response.content = "No content in response";
-            response.success = false;
-        }
-    } catch (const nlohmann::json::exception& e) {
-        response.content = "Failed to parse response: " + std::string(e.what());
+    // SAX extraction pulls just choices[0].message.content out of the body
+    // without materializing a DOM for large completions.
+    auto extracted = extractJsonStringField(http_response.body, {"choices", 0, "message", "content"});
+    if (extracted.found) {
+        response.content = extracted.value;
+    } else if (extracted.parse_error) {
+        response.content = "Failed to parse response";
+        response.success = false;
+    } else {
+        response.content = "No content in response";
         response.success = false;
     }
 
+    // The body is fully consumed; hand its capacity back for reuse.
+    BufferPool::shared().release(std::move(http_response.body));
+
     return response;
 }
 
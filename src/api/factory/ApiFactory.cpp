@@ -1,20 +1,47 @@
 #include "ApiFactory.h"
+#include "ProviderRegistry.h"
 #include "../clients/AnthropicClient.h"
 #include "../clients/OpenAIClient.h"
 #include "../clients/GeminiClient.h"
 #include "../clients/CohereClient.h"
 #include "../base/ApiException.h"
+#include "../base/AsyncHttpClient.h"
+#include "../base/CurlHandlePool.h"
+#include "../base/RetryPolicy.h"
+#include "../base/ResponseCache.h"
+#include <chrono>
+#include <condition_variable>
+#include <thread>
 
 namespace api {
 
+namespace {
+
+// The built-in providers, resolved to direct constructor calls at compile
+// time. Adding a client here (plus its kProviderId) is the whole
+// registration; no runtime setup runs at factory construction.
+using BuiltinProviders = ProviderList<AnthropicClient,
+                                      OpenAIClient,
+                                      GeminiClient,
+                                      CohereClient>;
+
+} // namespace
+
 ApiFactory::ApiFactory(config::ConfigManager& config_manager)
     : config_manager_(config_manager) {
-    initializeBuiltinProviders();
+    // Size the shared transports from the configured connection pool so
+    // every client created here draws on the same warm connections.
+    const auto& pool_config = config_manager_.getGlobalConfig().connection_pool;
+    CurlHandlePool::shared().configure(pool_config);
+    AsyncHttpClient::shared().setMaxConnections(pool_config.max_connections);
+    AsyncHttpClient::shared().setMaxHostConnections(pool_config.max_host_connections);
+    RetryPolicy::setDefaults(RetryPolicy::fromConfig(pool_config));
+    ResponseCache::shared().configure(config_manager_.getGlobalConfig().response_cache);
 }
 
 ApiClientPtr ApiFactory::createClient(const std::string& provider) {
-    auto it = creators_.find(provider);
-    if (it == creators_.end()) {
+    auto plugin = plugin_creators_.find(provider);
+    if (!BuiltinProviders::contains(provider) && plugin == plugin_creators_.end()) {
         throw ApiException("Unsupported provider: " + provider);
     }
 
@@ -24,30 +51,141 @@ ApiClientPtr ApiFactory::createClient(const std::string& provider) {
 
     try {
         auto config = config_manager_.getApiConfig(provider);
-        return it->second(config);
+        if (auto client = BuiltinProviders::create(provider, *config)) {
+            return client;
+        }
+        return plugin->second(*config);
     } catch (const std::exception& e) {
         throw ApiException("Failed to create client for provider '" + provider + "': " + e.what());
     }
 }
 
+std::shared_ptr<IApiClient> ApiFactory::getClient(const std::string& provider) {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+
+    // Drop every cached client when the configuration has been reloaded so
+    // changed settings take effect on the next request.
+    auto generation = config_manager_.getConfigGeneration();
+    if (generation != cached_generation_) {
+        clients_.clear();
+        cached_generation_ = generation;
+    }
+
+    auto it = clients_.find(provider);
+    if (it != clients_.end()) {
+        return it->second;
+    }
+
+    std::shared_ptr<IApiClient> client = createClient(provider);
+    clients_[provider] = client;
+    return client;
+}
+
+void ApiFactory::invalidateClients() {
+    std::lock_guard<std::mutex> lock(clients_mutex_);
+    clients_.clear();
+}
+
+ApiResponse ApiFactory::sendMessageHedged(const std::string& primary_provider,
+                                          const MessageRequest& request,
+                                          const HedgePolicy& policy) {
+    struct HedgeState {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool primary_done = false;
+        bool secondary_done = false;
+        ApiResponse primary_response;
+        ApiResponse secondary_response;
+    };
+
+    auto state = std::make_shared<HedgeState>();
+
+    auto launch = [&request](std::shared_ptr<IApiClient> client,
+                             std::shared_ptr<HedgeState> shared_state,
+                             bool is_primary) {
+        std::thread([client, shared_state, is_primary, request]() {
+            ApiResponse response;
+            try {
+                response = client->sendMessage(request);
+            } catch (const std::exception& e) {
+                response.success = false;
+                response.status_code = 0;
+                response.error_message = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(shared_state->mutex);
+            if (is_primary) {
+                shared_state->primary_done = true;
+                shared_state->primary_response = std::move(response);
+            } else {
+                shared_state->secondary_done = true;
+                shared_state->secondary_response = std::move(response);
+            }
+            shared_state->cv.notify_all();
+        }).detach();
+    };
+
+    // Each hedge thread owns a fresh client: the loser keeps running
+    // detached after this call returns, and a cached client it still holds
+    // could otherwise be handed to a later request mid-transfer.
+    launch(createClient(primary_provider), state, true);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    bool primary_in_budget = state->cv.wait_for(
+        lock, std::chrono::milliseconds(policy.hedge_delay_ms),
+        [&state] { return state->primary_done; });
+
+    if (primary_in_budget && state->primary_response.success) {
+        return state->primary_response;
+    }
+
+    // Primary blew its latency budget (or already failed): duplicate the
+    // request to the secondary and take the first success. The loser keeps
+    // running detached and is dropped on completion, like raceProviders.
+    lock.unlock();
+    launch(createClient(policy.secondary_provider), state, false);
+    lock.lock();
+
+    state->cv.wait(lock, [&state] {
+        return (state->primary_done && state->primary_response.success) ||
+               (state->secondary_done && state->secondary_response.success) ||
+               (state->primary_done && state->secondary_done);
+    });
+
+    if (state->primary_done && state->primary_response.success) {
+        return state->primary_response;
+    }
+    if (state->secondary_done && state->secondary_response.success) {
+        return state->secondary_response;
+    }
+    return state->primary_response;
+}
+
 std::vector<std::string> ApiFactory::getAvailableProviders() const {
+    std::vector<std::string> supported;
+    BuiltinProviders::appendNames(supported);
+    for (const auto& pair : plugin_creators_) {
+        supported.push_back(pair.first);
+    }
+
     std::vector<std::string> providers;
-    for (const auto& pair : creators_) {
-        if (config_manager_.hasProvider(pair.first)) {
-            providers.push_back(pair.first);
+    for (const auto& name : supported) {
+        if (config_manager_.hasProvider(name)) {
+            providers.push_back(name);
         }
     }
     return providers;
 }
 
 bool ApiFactory::isProviderSupported(const std::string& provider) const {
-    return creators_.find(provider) != creators_.end() &&
+    return (BuiltinProviders::contains(provider) ||
+            plugin_creators_.find(provider) != plugin_creators_.end()) &&
            config_manager_.hasProvider(provider);
 }
 
 void ApiFactory::registerProvider(const std::string& provider,
                                 std::function<ApiClientPtr(const config::ApiConfig&)> creator) {
-    creators_[provider] = creator;
+    plugin_creators_[provider] = creator;
 }
 
 std::map<std::string, std::string> ApiFactory::getProviderInfo() const {
@@ -56,7 +194,7 @@ std::map<std::string, std::string> ApiFactory::getProviderInfo() const {
     for (const auto& provider : getAvailableProviders()) {
         try {
             auto config = config_manager_.getApiConfig(provider);
-            info[provider] = config.name + " (" + config.base_url + ")";
+            info[provider] = config->name + " (" + config->base_url + ")";
         } catch (const std::exception& e) {
             info[provider] = "Error: " + std::string(e.what());
         }
@@ -65,38 +203,4 @@ std::map<std::string, std::string> ApiFactory::getProviderInfo() const {
     return info;
 }
 
-void ApiFactory::initializeBuiltinProviders() {
-    creators_["anthropic"] = [this](const config::ApiConfig& config) {
-        return createAnthropicClient(config);
-    };
-
-    creators_["openai"] = [this](const config::ApiConfig& config) {
-        return createOpenAIClient(config);
-    };
-
-    creators_["gemini"] = [this](const config::ApiConfig& config) {
-        return createGeminiClient(config);
-    };
-
-    creators_["cohere"] = [this](const config::ApiConfig& config) {
-        return createCohereClient(config);
-    };
-}
-
-ApiClientPtr ApiFactory::createAnthropicClient(const config::ApiConfig& config) {
-    return std::make_unique<AnthropicClient>(config);
-}
-
-ApiClientPtr ApiFactory::createOpenAIClient(const config::ApiConfig& config) {
-    return std::make_unique<OpenAIClient>(config);
-}
-
-ApiClientPtr ApiFactory::createGeminiClient(const config::ApiConfig& config) {
-    return std::make_unique<GeminiClient>(config);
-}
-
-ApiClientPtr ApiFactory::createCohereClient(const config::ApiConfig& config) {
-    return std::make_unique<CohereClient>(config);
-}
-
 } // namespace api
\ No newline at end of file
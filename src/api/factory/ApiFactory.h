@@ -6,9 +6,18 @@
 #include <string>
 #include <map>
 #include <functional>
+#include <mutex>
+#include <cstdint>
 
 namespace api {
 
+// Hedged-send tuning: which provider duplicates the request and how long
+// the primary may run before the duplicate is launched.
+struct HedgePolicy {
+    std::string secondary_provider;
+    int hedge_delay_ms = 1000;
+};
+
 class ApiFactory {
 public:
     explicit ApiFactory(config::ConfigManager& config_manager);
@@ -19,10 +28,31 @@ public:
 
     ApiClientPtr createClient(const std::string& provider);
 
+    // Returns a shared client for the provider, constructing it at most once
+    // per configuration generation. The cache is invalidated automatically
+    // after ConfigManager::reloadConfig, or explicitly via invalidateClients.
+    // Clients themselves are not thread-safe: callers that issue requests
+    // concurrently must give each thread its own client via createClient
+    // instead of sharing a cached one.
+    std::shared_ptr<IApiClient> getClient(const std::string& provider);
+
+    void invalidateClients();
+
+    // Sends through the primary provider and, if it exceeds the policy's
+    // latency budget, duplicates the request to the secondary provider and
+    // returns whichever answers first. The slower transfer is abandoned, not
+    // awaited — this trades a duplicate request for a bounded p99 during
+    // provider brownouts.
+    ApiResponse sendMessageHedged(const std::string& primary_provider,
+                                  const MessageRequest& request,
+                                  const HedgePolicy& policy);
+
     std::vector<std::string> getAvailableProviders() const;
 
     bool isProviderSupported(const std::string& provider) const;
 
+    // Dynamic escape hatch for plugins. Built-in providers are enumerated at
+    // compile time (see ProviderRegistry.h) and never touch this map.
     void registerProvider(const std::string& provider,
                          std::function<ApiClientPtr(const config::ApiConfig&)> creator);
 
@@ -30,14 +60,10 @@ public:
 
 private:
     config::ConfigManager& config_manager_;
-    std::map<std::string, std::function<ApiClientPtr(const config::ApiConfig&)>> creators_;
-
-    void initializeBuiltinProviders();
-
-    ApiClientPtr createAnthropicClient(const config::ApiConfig& config);
-    ApiClientPtr createOpenAIClient(const config::ApiConfig& config);
-    ApiClientPtr createGeminiClient(const config::ApiConfig& config);
-    ApiClientPtr createCohereClient(const config::ApiConfig& config);
+    std::map<std::string, std::function<ApiClientPtr(const config::ApiConfig&)>> plugin_creators_;
+    std::mutex clients_mutex_;
+    std::map<std::string, std::shared_ptr<IApiClient>> clients_;
+    std::uint64_t cached_generation_ = 0;
 };
 
 } // namespace api
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../base/IApiClient.h"
+#include "../../config/ApiConfig.h"
+#include <string_view>
+#include <vector>
+
+namespace api {
+
+// Compile-time provider registry. Each client class in the list exposes a
+// `static constexpr std::string_view kProviderId`; dispatch unrolls into a
+// chain of string_view comparisons against those constants, and creation is
+// a direct constructor call the optimizer can see through — no type-erased
+// std::function hop for the built-in providers. Dynamically registered
+// plugins still go through ApiFactory::registerProvider.
+template <typename... Clients>
+struct ProviderList {
+    static bool contains(std::string_view provider) {
+        return ((provider == Clients::kProviderId) || ...);
+    }
+
+    // Returns nullptr when the provider is not in the list.
+    static ApiClientPtr create(std::string_view provider,
+                               const config::ApiConfig& config) {
+        ApiClientPtr client;
+        ((provider == Clients::kProviderId
+              ? (client = std::make_unique<Clients>(config), true)
+              : false) ||
+         ...);
+        return client;
+    }
+
+    static void appendNames(std::vector<std::string>& names) {
+        (names.emplace_back(Clients::kProviderId), ...);
+    }
+};
+
+} // namespace api
@@ -0,0 +1,210 @@
+// Micro-benchmarks for the framework's hot paths: payload building,
+// response parsing, SSE splitting, config loading and the shared pools.
+// Everything runs in-process against synthetic data — no network involved —
+// so per-commit numbers are stable enough to chart.
+//
+// Built only when Google Benchmark is installed; see src/CMakeLists.txt.
+
+#include "api/base/Conversation.h"
+#include "api/base/JsonExtractor.h"
+#include "api/base/SseParser.h"
+#include "api/base/BufferPool.h"
+#include "api/base/Metrics.h"
+#include "api/base/ResponseCache.h"
+#include "config/ConfigManager.h"
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+// Transcript with `turns` user/assistant exchanges.
+api::Conversation makeConversation(int turns) {
+    api::Conversation conversation;
+    for (int i = 0; i < turns; ++i) {
+        conversation.addUserMessage("question number " + std::to_string(i) +
+                                    " with some typical prompt text attached");
+        conversation.addAssistantMessage("answer number " + std::to_string(i) +
+                                         " with a couple of sentences of reply text");
+    }
+    return conversation;
+}
+
+// Synthetic Anthropic-shaped response body with `text_bytes` of content.
+std::string makeResponseBody(size_t text_bytes) {
+    nlohmann::json body = {
+        {"id", "msg_bench"},
+        {"model", "bench-model"},
+        {"content", nlohmann::json::array({
+            {{"type", "text"}, {"text", std::string(text_bytes, 'x')}}
+        })},
+        {"usage", {{"input_tokens", 10}, {"output_tokens", 1000}}}
+    };
+    return body.dump();
+}
+
+const char* kBenchConfigPath = "/tmp/ai-cli-bench-config.json";
+
+void writeBenchConfig() {
+    static bool written = false;
+    if (written) {
+        return;
+    }
+    written = true;
+
+    setenv("AI_CLI_BENCH_KEY", "benchmark", 1);
+
+    std::ofstream file(kBenchConfigPath, std::ios::trunc);
+    file << R"({
+  "apis": {
+    "anthropic": {
+      "name": "Anthropic API",
+      "base_url": "https://bench.invalid",
+      "endpoints": {"messages": "/v1/messages"},
+      "auth": {"type": "header", "header_name": "x-api-key", "env_var": "AI_CLI_BENCH_KEY"},
+      "default_model": "bench-model",
+      "max_tokens": 128,
+      "timeout": 1000
+    }
+  },
+  "connection_pool": {"max_connections": 4}
+})";
+}
+
+} // namespace
+
+// Payload building: serialize a transcript's messages array through the
+// Conversation prefix cache (only the new turn is serialized)...
+static void BM_ConversationSerializeCached(benchmark::State& state) {
+    auto conversation = makeConversation(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(conversation.serializeMessages("the next question"));
+    }
+}
+BENCHMARK(BM_ConversationSerializeCached)->Arg(10)->Arg(100);
+
+// ...versus rebuilding and dumping the whole DOM each call, which is what
+// buildMessagePayload does when no cached prefix is supplied.
+static void BM_TranscriptSerializeDom(benchmark::State& state) {
+    auto conversation = makeConversation(static_cast<int>(state.range(0)));
+    const auto& history = conversation.messages();
+    for (auto _ : state) {
+        auto messages = nlohmann::json::array();
+        for (const auto& turn : history) {
+            messages.push_back({{"role", turn.role}, {"content", turn.content}});
+        }
+        messages.push_back({{"role", "user"}, {"content", "the next question"}});
+        benchmark::DoNotOptimize(messages.dump());
+    }
+}
+BENCHMARK(BM_TranscriptSerializeDom)->Arg(10)->Arg(100);
+
+// Response parsing: SAX extraction of content[0].text as parseResponse
+// does it...
+static void BM_ExtractFieldSax(benchmark::State& state) {
+    auto body = makeResponseBody(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            api::extractJsonStringField(body, {"content", 0, "text"}));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_ExtractFieldSax)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// ...versus materializing the full DOM first.
+static void BM_ExtractFieldDom(benchmark::State& state) {
+    auto body = makeResponseBody(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto json = nlohmann::json::parse(body);
+        benchmark::DoNotOptimize(json["content"][0]["text"].get<std::string>());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_ExtractFieldDom)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+// SSE splitting across chunk boundaries, as the streaming path drives it.
+static void BM_SseParserFeed(benchmark::State& state) {
+    std::string chunk;
+    for (int i = 0; i < 64; ++i) {
+        chunk += "event: content_block_delta\n";
+        chunk += "data: {\"type\":\"content_block_delta\",\"delta\":{\"text\":\"token\"}}\n\n";
+    }
+
+    size_t events = 0;
+    for (auto _ : state) {
+        api::SseParser parser([&events](const std::string&) { ++events; });
+        parser.feed(chunk.data(), chunk.size());
+    }
+    benchmark::DoNotOptimize(events);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * chunk.size()));
+}
+BENCHMARK(BM_SseParserFeed);
+
+// Config loading from JSON text (snapshot removed each iteration)...
+static void BM_ConfigLoadCold(benchmark::State& state) {
+    writeBenchConfig();
+    std::string snapshot = std::string(kBenchConfigPath) + ".snapshot";
+    for (auto _ : state) {
+        unlink(snapshot.c_str());
+        config::ConfigManager manager(kBenchConfigPath);
+        benchmark::DoNotOptimize(manager.getGlobalConfig());
+    }
+}
+BENCHMARK(BM_ConfigLoadCold);
+
+// ...versus the mmap'd CBOR snapshot fast path.
+static void BM_ConfigLoadSnapshot(benchmark::State& state) {
+    writeBenchConfig();
+    { config::ConfigManager seed(kBenchConfigPath); } // seed the snapshot
+    for (auto _ : state) {
+        config::ConfigManager manager(kBenchConfigPath);
+        benchmark::DoNotOptimize(manager.getGlobalConfig());
+    }
+}
+BENCHMARK(BM_ConfigLoadSnapshot);
+
+// Body-buffer recycling through the shared pool.
+static void BM_BufferPoolCycle(benchmark::State& state) {
+    for (auto _ : state) {
+        auto buffer = api::BufferPool::shared().acquire();
+        buffer.append(4096, 'x');
+        api::BufferPool::shared().release(std::move(buffer));
+    }
+}
+BENCHMARK(BM_BufferPoolCycle);
+
+// Per-transfer metrics recording (runs once per request under load).
+static void BM_MetricsRecord(benchmark::State& state) {
+    api::TransferTiming timing;
+    timing.total_ms = 123.0;
+    for (auto _ : state) {
+        api::MetricsRegistry::shared().record("bench", timing, true);
+    }
+}
+BENCHMARK(BM_MetricsRecord);
+
+// Response-cache hit from the in-memory LRU tier.
+static void BM_ResponseCacheHit(benchmark::State& state) {
+    config::CacheConfig cache_config;
+    cache_config.enabled = true;
+    cache_config.path = "/tmp/ai-cli-bench-cache";
+    api::ResponseCache::shared().configure(cache_config);
+
+    api::ApiResponse response;
+    response.content = "cached answer";
+    response.status_code = 200;
+    response.success = true;
+    api::ResponseCache::shared().store("bench", "{\"payload\":1}", response);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            api::ResponseCache::shared().lookup("bench", "{\"payload\":1}"));
+    }
+}
+BENCHMARK(BM_ResponseCacheHit);
+
+BENCHMARK_MAIN();
@@ -20,12 +20,26 @@ struct EndpointConfig {
 
 struct ConnectionPoolConfig {
     int max_connections = 10;
+    // Connection cap per provider host; with HTTP/2 multiplexing a burst of
+    // concurrent requests shares this many TLS connections as streams.
+    int max_host_connections = 2;
     bool keep_alive = true;
     bool verify_ssl = true;
     int retry_attempts = 3;
     int retry_delay = 1000; // milliseconds
 };
 
+struct RateLimitConfig {
+    double requests_per_second = 0.0; // 0 disables local pacing
+    int burst = 1;
+};
+
+struct CacheConfig {
+    bool enabled = false;       // response caching is opt-in
+    int max_entries = 1024;     // in-memory LRU tier size
+    std::string path = "./response-cache";
+};
+
 struct LoggingConfig {
     std::string level = "INFO";
     bool log_requests = false;
@@ -43,11 +57,13 @@ struct ApiConfig {
     int timeout = 30000; // milliseconds
     double temperature = 0.7;
     std::vector<std::string> stop_sequences;
+    RateLimitConfig rate_limit;
 };
 
 struct GlobalConfig {
     std::map<std::string, ApiConfig> apis;
     ConnectionPoolConfig connection_pool;
+    CacheConfig response_cache;
     LoggingConfig logging;
 };
 
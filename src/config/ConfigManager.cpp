@@ -3,79 +3,189 @@
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace config {
 
 ConfigManager::ConfigManager(const std::string& config_file_path)
     : config_file_path_(config_file_path) {
     loadConfig();
-    loadEnvironmentVariables();
-    validateConfig();
+}
+
+ConfigManager::~ConfigManager() {
+    stopWatching();
 }
 
 const GlobalConfig& ConfigManager::getGlobalConfig() const {
-    return global_config_;
+    return *snapshot_.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const GlobalConfig> ConfigManager::getConfigSnapshot() const {
+    return snapshot_.load(std::memory_order_acquire);
 }
 
-ApiConfig ConfigManager::getApiConfig(const std::string& provider) const {
-    auto it = global_config_.apis.find(provider);
-    if (it == global_config_.apis.end()) {
+std::shared_ptr<const ApiConfig> ConfigManager::getApiConfig(const std::string& provider) const {
+    auto snapshot = snapshot_.load(std::memory_order_acquire);
+    auto it = snapshot->apis.find(provider);
+    if (it == snapshot->apis.end()) {
         throw api::ConfigException("Provider '" + provider + "' not found in configuration");
     }
-    return it->second;
+    // Aliasing constructor: the pointer addresses the entry inside the
+    // snapshot but shares the snapshot's lifetime, so the entry stays valid
+    // even if a reload publishes a replacement while the caller holds it.
+    return std::shared_ptr<const ApiConfig>(snapshot, &it->second);
 }
 
 std::vector<std::string> ConfigManager::getAvailableProviders() const {
+    auto snapshot = snapshot_.load(std::memory_order_acquire);
     std::vector<std::string> providers;
-    for (const auto& pair : global_config_.apis) {
+    for (const auto& pair : snapshot->apis) {
         providers.push_back(pair.first);
     }
     return providers;
 }
 
 void ConfigManager::setApiTimeout(const std::string& provider, int timeout_ms) {
-    auto it = global_config_.apis.find(provider);
-    if (it != global_config_.apis.end()) {
-        it->second.timeout = timeout_ms;
-    } else {
-        throw api::ConfigException("Provider '" + provider + "' not found");
-    }
+    mutateApi(provider, [timeout_ms](ApiConfig& config) {
+        config.timeout = timeout_ms;
+    });
 }
 
 void ConfigManager::setMaxTokens(const std::string& provider, int max_tokens) {
-    auto it = global_config_.apis.find(provider);
-    if (it != global_config_.apis.end()) {
-        it->second.max_tokens = max_tokens;
-    } else {
-        throw api::ConfigException("Provider '" + provider + "' not found");
-    }
+    mutateApi(provider, [max_tokens](ApiConfig& config) {
+        config.max_tokens = max_tokens;
+    });
 }
 
 void ConfigManager::setTemperature(const std::string& provider, double temperature) {
-    auto it = global_config_.apis.find(provider);
-    if (it != global_config_.apis.end()) {
-        it->second.temperature = temperature;
-    } else {
+    mutateApi(provider, [temperature](ApiConfig& config) {
+        config.temperature = temperature;
+    });
+}
+
+void ConfigManager::mutateApi(const std::string& provider,
+                              const std::function<void(ApiConfig&)>& mutate) {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    auto current = snapshot_.load(std::memory_order_acquire);
+    auto updated = std::make_shared<GlobalConfig>(*current);
+
+    auto it = updated->apis.find(provider);
+    if (it == updated->apis.end()) {
         throw api::ConfigException("Provider '" + provider + "' not found");
     }
+    mutate(it->second);
+
+    snapshot_.store(std::shared_ptr<const GlobalConfig>(std::move(updated)),
+                    std::memory_order_release);
 }
 
 bool ConfigManager::hasProvider(const std::string& provider) const {
-    return global_config_.apis.find(provider) != global_config_.apis.end();
+    auto snapshot = snapshot_.load(std::memory_order_acquire);
+    return snapshot->apis.find(provider) != snapshot->apis.end();
 }
 
 void ConfigManager::reloadConfig() {
+    // The entire parse/validate runs off the hot path on the caller's
+    // thread; readers keep serving the old snapshot until the single
+    // pointer swap inside loadConfig.
+    std::lock_guard<std::mutex> lock(publish_mutex_);
     loadConfig();
-    loadEnvironmentVariables();
-    validateConfig();
+    config_generation_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t ConfigManager::getConfigGeneration() const {
+    return config_generation_.load(std::memory_order_relaxed);
+}
+
+void ConfigManager::startWatching() {
+    if (watching_.exchange(true)) {
+        return;
+    }
+    watcher_ = std::thread(&ConfigManager::watchLoop, this);
+}
+
+void ConfigManager::stopWatching() {
+    if (!watching_.exchange(false)) {
+        return;
+    }
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
+}
+
+void ConfigManager::watchLoop() {
+    int fd = inotify_init1(IN_NONBLOCK);
+    if (fd < 0) {
+        watching_.store(false);
+        return;
+    }
+
+    // Watch the directory rather than the file itself: editors and config
+    // management tools replace the file (write temp, then rename), which
+    // would orphan a watch pinned to the old inode.
+    std::string dir = ".";
+    std::string name = config_file_path_;
+    auto slash = config_file_path_.find_last_of('/');
+    if (slash != std::string::npos) {
+        dir = slash == 0 ? "/" : config_file_path_.substr(0, slash);
+        name = config_file_path_.substr(slash + 1);
+    }
+
+    int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0) {
+        close(fd);
+        watching_.store(false);
+        return;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (watching_.load(std::memory_order_acquire)) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        bool touched = false;
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && name == event->name) {
+                touched = true;
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+
+        if (touched) {
+            try {
+                reloadConfig();
+            } catch (const std::exception& e) {
+                // A half-written or invalid config must not take down the
+                // process; keep serving the previous snapshot.
+                std::cerr << "Warning: config reload failed, keeping previous config: "
+                          << e.what() << "\n";
+            }
+        }
+    }
+
+    close(fd);
 }
 
 void ConfigManager::validateConfig() const {
-    if (global_config_.apis.empty()) {
+    validateConfig(*snapshot_.load(std::memory_order_acquire));
+}
+
+void ConfigManager::validateConfig(const GlobalConfig& global_config) const {
+    if (global_config.apis.empty()) {
         throw api::ConfigException("No API providers configured");
     }
 
-    for (const auto& pair : global_config_.apis) {
+    for (const auto& pair : global_config.apis) {
         const auto& provider = pair.first;
         const auto& config = pair.second;
 
@@ -106,38 +216,70 @@ std::string ConfigManager::getConfigPath() const {
 }
 
 void ConfigManager::loadConfig() {
-    std::ifstream file(config_file_path_);
-    if (!file.is_open()) {
-        throw api::ConfigException("Failed to open config file: " + config_file_path_);
+    nlohmann::json json;
+    bool from_snapshot = true;
+
+    // Fast path: deserialize the binary snapshot when the source file is
+    // unchanged, skipping the JSON text parse entirely.
+    if (!loadSnapshot(json)) {
+        from_snapshot = false;
+
+        std::ifstream file(config_file_path_);
+        if (!file.is_open()) {
+            throw api::ConfigException("Failed to open config file: " + config_file_path_);
+        }
+
+        try {
+            file >> json;
+        } catch (const nlohmann::json::exception& e) {
+            throw api::ConfigException("Failed to parse JSON config: " + std::string(e.what()));
+        }
     }
 
-    nlohmann::json json;
-    try {
-        file >> json;
-    } catch (const nlohmann::json::exception& e) {
-        throw api::ConfigException("Failed to parse JSON config: " + std::string(e.what()));
+    // Build and validate the new configuration off to the side, then make
+    // it visible in one swap: readers only ever observe fully-formed,
+    // validated snapshots.
+    GlobalConfig global_config = parseGlobalConfig(json);
+    loadEnvironmentVariables(global_config);
+    validateConfig(global_config);
+    snapshot_.store(std::make_shared<const GlobalConfig>(std::move(global_config)),
+                    std::memory_order_release);
+
+    if (!from_snapshot) {
+        saveSnapshot(json);
     }
+}
+
+GlobalConfig ConfigManager::parseGlobalConfig(const nlohmann::json& json) const {
+    GlobalConfig global_config;
 
     // Parse APIs
     if (json.contains("apis") && json["apis"].is_object()) {
         for (const auto& item : json["apis"].items()) {
-            global_config_.apis[item.key()] = parseApiConfig(item.value());
+            global_config.apis[item.key()] = parseApiConfig(item.value());
         }
     }
 
     // Parse connection pool config
     if (json.contains("connection_pool")) {
-        global_config_.connection_pool = parseConnectionPoolConfig(json["connection_pool"]);
+        global_config.connection_pool = parseConnectionPoolConfig(json["connection_pool"]);
+    }
+
+    // Parse response cache config
+    if (json.contains("response_cache")) {
+        global_config.response_cache = parseCacheConfig(json["response_cache"]);
     }
 
     // Parse logging config
     if (json.contains("logging")) {
-        global_config_.logging = parseLoggingConfig(json["logging"]);
+        global_config.logging = parseLoggingConfig(json["logging"]);
     }
+
+    return global_config;
 }
 
-void ConfigManager::loadEnvironmentVariables() {
-    for (auto& pair : global_config_.apis) {
+void ConfigManager::loadEnvironmentVariables(GlobalConfig& global_config) const {
+    for (auto& pair : global_config.apis) {
         auto& config = pair.second;
         if (!config.auth.env_var.empty()) {
             config.auth.token = getEnvironmentVariable(config.auth.env_var);
@@ -184,6 +326,10 @@ ApiConfig ConfigManager::parseApiConfig(const nlohmann::json& json) const {
         config.temperature = json["temperature"];
     }
 
+    if (json.contains("rate_limit")) {
+        config.rate_limit = parseRateLimitConfig(json["rate_limit"]);
+    }
+
     if (json.contains("stop_sequences") && json["stop_sequences"].is_array()) {
         for (const auto& item : json["stop_sequences"]) {
             if (item.is_string()) {
@@ -231,6 +377,20 @@ EndpointConfig ConfigManager::parseEndpointConfig(const nlohmann::json& json) co
     return config;
 }
 
+RateLimitConfig ConfigManager::parseRateLimitConfig(const nlohmann::json& json) const {
+    RateLimitConfig config;
+
+    if (json.contains("requests_per_second") && json["requests_per_second"].is_number()) {
+        config.requests_per_second = json["requests_per_second"];
+    }
+
+    if (json.contains("burst") && json["burst"].is_number_integer()) {
+        config.burst = json["burst"];
+    }
+
+    return config;
+}
+
 ConnectionPoolConfig ConfigManager::parseConnectionPoolConfig(const nlohmann::json& json) const {
     ConnectionPoolConfig config;
 
@@ -238,6 +398,10 @@ ConnectionPoolConfig ConfigManager::parseConnectionPoolConfig(const nlohmann::js
         config.max_connections = json["max_connections"];
     }
 
+    if (json.contains("max_host_connections") && json["max_host_connections"].is_number_integer()) {
+        config.max_host_connections = json["max_host_connections"];
+    }
+
     if (json.contains("keep_alive") && json["keep_alive"].is_boolean()) {
         config.keep_alive = json["keep_alive"];
     }
@@ -257,6 +421,24 @@ ConnectionPoolConfig ConfigManager::parseConnectionPoolConfig(const nlohmann::js
     return config;
 }
 
+CacheConfig ConfigManager::parseCacheConfig(const nlohmann::json& json) const {
+    CacheConfig config;
+
+    if (json.contains("enabled") && json["enabled"].is_boolean()) {
+        config.enabled = json["enabled"];
+    }
+
+    if (json.contains("max_entries") && json["max_entries"].is_number_integer()) {
+        config.max_entries = json["max_entries"];
+    }
+
+    if (json.contains("path") && json["path"].is_string()) {
+        config.path = json["path"];
+    }
+
+    return config;
+}
+
 LoggingConfig ConfigManager::parseLoggingConfig(const nlohmann::json& json) const {
     LoggingConfig config;
 
@@ -275,6 +457,104 @@ LoggingConfig ConfigManager::parseLoggingConfig(const nlohmann::json& json) cons
     return config;
 }
 
+namespace {
+
+// Snapshot layout: header identifying the source file state, followed by
+// the config document serialized as CBOR.
+struct SnapshotHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::int64_t source_mtime;
+    std::uint64_t source_size;
+};
+
+constexpr char kSnapshotMagic[4] = {'A', 'C', 'F', 'G'};
+constexpr std::uint32_t kSnapshotVersion = 2;
+
+// Nanosecond mtime, so a hot-reload of a file rewritten within the same
+// second (and at the same size) still invalidates the snapshot.
+std::int64_t mtimeNanos(const struct stat& file_stat) {
+    return static_cast<std::int64_t>(file_stat.st_mtim.tv_sec) * 1000000000 +
+           static_cast<std::int64_t>(file_stat.st_mtim.tv_nsec);
+}
+
+} // namespace
+
+std::string ConfigManager::snapshotPath() const {
+    return config_file_path_ + ".snapshot";
+}
+
+bool ConfigManager::loadSnapshot(nlohmann::json& json) const {
+    struct stat source_stat;
+    if (stat(config_file_path_.c_str(), &source_stat) != 0) {
+        return false;
+    }
+
+    int fd = open(snapshotPath().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat snapshot_stat;
+    if (fstat(fd, &snapshot_stat) != 0 ||
+        snapshot_stat.st_size <= static_cast<off_t>(sizeof(SnapshotHeader))) {
+        close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(snapshot_stat.st_size);
+    void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    bool loaded = false;
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+
+    SnapshotHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) == 0 &&
+        header.version == kSnapshotVersion &&
+        header.source_mtime == mtimeNanos(source_stat) &&
+        header.source_size == static_cast<std::uint64_t>(source_stat.st_size)) {
+        try {
+            json = nlohmann::json::from_cbor(bytes + sizeof(header), bytes + length);
+            loaded = true;
+        } catch (const nlohmann::json::exception&) {
+            // Corrupt snapshot; fall back to the JSON source.
+        }
+    }
+
+    munmap(data, length);
+    return loaded;
+}
+
+void ConfigManager::saveSnapshot(const nlohmann::json& json) const {
+    struct stat source_stat;
+    if (stat(config_file_path_.c_str(), &source_stat) != 0) {
+        return;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.source_mtime = mtimeNanos(source_stat);
+    header.source_size = static_cast<std::uint64_t>(source_stat.st_size);
+
+    auto cbor = nlohmann::json::to_cbor(json);
+
+    // Failures here just mean the next start pays the JSON parse again.
+    std::ofstream file(snapshotPath(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(cbor.data()),
+               static_cast<std::streamsize>(cbor.size()));
+}
+
 std::string ConfigManager::getEnvironmentVariable(const std::string& var_name) const {
     const char* value = std::getenv(var_name.c_str());
     return value ? std::string(value) : std::string();
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "ApiConfig.h"
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 
 namespace config {
@@ -10,14 +15,23 @@ namespace config {
 class ConfigManager {
 public:
     explicit ConfigManager(const std::string& config_file_path);
-    ~ConfigManager() = default;
+    ~ConfigManager();
 
     ConfigManager(const ConfigManager&) = delete;
     ConfigManager& operator=(const ConfigManager&) = delete;
 
+    // The reference stays valid until the next reload publishes a new
+    // snapshot; code that outlives a reload should hold getConfigSnapshot()
+    // instead.
     const GlobalConfig& getGlobalConfig() const;
 
-    ApiConfig getApiConfig(const std::string& provider) const;
+    // Immutable view of the configuration at the time of the call. Holding
+    // the pointer keeps that snapshot alive across any number of reloads.
+    std::shared_ptr<const GlobalConfig> getConfigSnapshot() const;
+
+    // Aliases into the current snapshot, so the request path pays one atomic
+    // load and a map lookup instead of a deep per-call copy.
+    std::shared_ptr<const ApiConfig> getApiConfig(const std::string& provider) const;
 
     std::vector<std::string> getAvailableProviders() const;
 
@@ -31,24 +45,62 @@ public:
 
     void reloadConfig();
 
+    // Monotonic counter bumped by reloadConfig; consumers cache it to detect
+    // when derived state (e.g. constructed clients) has gone stale.
+    std::uint64_t getConfigGeneration() const;
+
     void validateConfig() const;
 
+    // Watches the config file's directory on a background thread and
+    // republishes the snapshot whenever the file is rewritten; readers on
+    // the request path never block on a reload. A config that fails to
+    // parse or validate leaves the previous snapshot in place.
+    void startWatching();
+    void stopWatching();
+
     std::string getConfigPath() const;
 
 private:
     std::string config_file_path_;
-    GlobalConfig global_config_;
+
+    // Readers take an atomic load; writers build a fresh GlobalConfig off
+    // the hot path and publish it here in a single pointer swap.
+    std::atomic<std::shared_ptr<const GlobalConfig>> snapshot_;
+    std::atomic<std::uint64_t> config_generation_{0};
+
+    // Serializes writers (reload and the set* mutators); readers never take it.
+    mutable std::mutex publish_mutex_;
+
+    std::thread watcher_;
+    std::atomic<bool> watching_{false};
 
     void loadConfig();
-    void loadEnvironmentVariables();
+    void watchLoop();
+    GlobalConfig parseGlobalConfig(const nlohmann::json& json) const;
+    void loadEnvironmentVariables(GlobalConfig& config) const;
+    void validateConfig(const GlobalConfig& config) const;
+
+    // Copy-on-write mutation of one provider's entry: clones the current
+    // snapshot, applies the edit, and publishes the clone.
+    void mutateApi(const std::string& provider,
+                   const std::function<void(ApiConfig&)>& mutate);
+
+    // Binary snapshot cache: the parsed document is serialized as CBOR next
+    // to the config file and mmap'd back on later starts, skipping the JSON
+    // text parse whenever the source file's mtime and size are unchanged.
+    std::string snapshotPath() const;
+    bool loadSnapshot(nlohmann::json& json) const;
+    void saveSnapshot(const nlohmann::json& json) const;
 
     ApiConfig parseApiConfig(const nlohmann::json& json) const;
     AuthConfig parseAuthConfig(const nlohmann::json& json) const;
     EndpointConfig parseEndpointConfig(const nlohmann::json& json) const;
+    RateLimitConfig parseRateLimitConfig(const nlohmann::json& json) const;
     ConnectionPoolConfig parseConnectionPoolConfig(const nlohmann::json& json) const;
+    CacheConfig parseCacheConfig(const nlohmann::json& json) const;
     LoggingConfig parseLoggingConfig(const nlohmann::json& json) const;
 
     std::string getEnvironmentVariable(const std::string& var_name) const;
 };
 
-} // namespace config
\ No newline at end of file
+} // namespace config
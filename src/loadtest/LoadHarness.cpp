@@ -0,0 +1,275 @@
+#include "MockProviderServer.h"
+#include "../api/factory/ApiFactory.h"
+#include "../api/base/Telemetry.h"
+#include "../config/ConfigManager.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Process-wide heap allocation counter: every operator new bumps it, so the
+// report can show allocations per request and regressions in the zero-copy
+// and buffer-reuse paths show up as numbers, not guesses.
+namespace {
+std::atomic<std::uint64_t> g_allocation_count{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Config pointing every provider at the mock server, with rate limiting
+// effectively off and fast retries so injected 429s resolve quickly.
+std::string writeHarnessConfig(const std::string& base_url) {
+    nlohmann::json config;
+
+    auto provider = [&](const std::string& key, const std::string& name,
+                        nlohmann::json endpoints, nlohmann::json auth,
+                        const std::string& model) {
+        config["apis"][key] = {
+            {"name", name},
+            {"base_url", base_url + "/" + key},
+            {"version", "v1"},
+            {"endpoints", std::move(endpoints)},
+            {"auth", std::move(auth)},
+            {"default_model", model},
+            {"max_tokens", 256},
+            {"timeout", 30000},
+            {"rate_limit", {{"requests_per_second", 100000.0}, {"burst", 100000}}}
+        };
+    };
+
+    provider("anthropic", "Anthropic Claude API",
+             {{"messages", "/messages"}, {"models", "/models"}},
+             {{"type", "header"}, {"header_name", "x-api-key"},
+              {"env_var", "MOCK_ANTHROPIC_KEY"}},
+             "claude-mock");
+    provider("openai", "OpenAI API",
+             {{"chat", "/chat/completions"}, {"models", "/models"}},
+             {{"type", "bearer"}, {"env_var", "MOCK_OPENAI_KEY"}},
+             "gpt-mock");
+    provider("gemini", "Google Gemini API",
+             {{"generate", "/models/gemini-mock:generateContent"}, {"models", "/models"}},
+             {{"type", "query_param"}, {"param_name", "key"},
+              {"env_var", "MOCK_GEMINI_KEY"}},
+             "gemini-mock");
+    provider("cohere", "Cohere API",
+             {{"chat", "/chat"}, {"models", "/models"}},
+             {{"type", "bearer"}, {"env_var", "MOCK_COHERE_KEY"}},
+             "command-mock");
+
+    config["connection_pool"] = {{"max_connections", 32},
+                                 {"max_host_connections", 8},
+                                 {"keep_alive", true},
+                                 {"verify_ssl", false},
+                                 {"retry_attempts", 4},
+                                 {"retry_delay", 10}};
+    config["response_cache"] = {{"enabled", false}};
+    config["logging"] = {{"level", "WARN"}};
+
+    std::string path = "/tmp/ai-cli-loadtest-config.json";
+    std::remove((path + ".snapshot").c_str());
+    std::ofstream out(path);
+    out << config.dump(2);
+    return path;
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void printUsage(const char* name) {
+    std::cout << "Usage: " << name << " [options]\n\n"
+              << "Drives the full client stack against an in-process mock provider\n"
+              << "server and reports throughput, latency percentiles and allocation\n"
+              << "counts.\n\n"
+              << "Options:\n"
+              << "  --provider <p>      anthropic|openai|gemini|cohere (default anthropic)\n"
+              << "  --requests <n>      total requests (default 200)\n"
+              << "  --concurrency <n>   worker threads (default 8)\n"
+              << "  --latency-ms <n>    mock base latency per response (default 5)\n"
+              << "  --jitter-ms <n>     uniform extra latency (default 5)\n"
+              << "  --error-rate <f>    fraction of responses answered 429 (default 0)\n"
+              << "  --stream            use the SSE streaming path\n"
+              << "  --help              show this help\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string provider = "anthropic";
+    int total_requests = 200;
+    int concurrency = 8;
+    loadtest::MockProviderServer::Options server_options;
+    server_options.base_latency_ms = 5;
+    server_options.jitter_ms = 5;
+    bool stream = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--provider" && i + 1 < argc) {
+            provider = argv[++i];
+        } else if (arg == "--requests" && i + 1 < argc) {
+            total_requests = std::atoi(argv[++i]);
+        } else if (arg == "--concurrency" && i + 1 < argc) {
+            concurrency = std::atoi(argv[++i]);
+        } else if (arg == "--latency-ms" && i + 1 < argc) {
+            server_options.base_latency_ms = std::atoi(argv[++i]);
+        } else if (arg == "--jitter-ms" && i + 1 < argc) {
+            server_options.jitter_ms = std::atoi(argv[++i]);
+        } else if (arg == "--error-rate" && i + 1 < argc) {
+            server_options.error_rate = std::atof(argv[++i]);
+        } else if (arg == "--stream") {
+            stream = true;
+        } else if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    setenv("MOCK_ANTHROPIC_KEY", "mock-key", 0);
+    setenv("MOCK_OPENAI_KEY", "mock-key", 0);
+    setenv("MOCK_GEMINI_KEY", "mock-key", 0);
+    setenv("MOCK_COHERE_KEY", "mock-key", 0);
+
+    loadtest::MockProviderServer server(server_options);
+    auto base_url = server.start();
+    if (base_url.empty()) {
+        std::cerr << "Failed to start mock server\n";
+        return 1;
+    }
+
+    try {
+        config::ConfigManager config_manager(writeHarnessConfig(base_url));
+        api::ApiFactory factory(config_manager);
+
+        std::cout << "Mock load test: provider=" << provider
+                  << " requests=" << total_requests
+                  << " concurrency=" << concurrency
+                  << (stream ? " (streaming)" : "") << "\n"
+                  << "  server latency " << server_options.base_latency_ms << "+"
+                  << server_options.jitter_ms << " ms, injected 429 rate "
+                  << server_options.error_rate << "\n\n";
+
+        std::vector<double> latencies_ms;
+        latencies_ms.reserve(total_requests);
+        std::mutex latencies_mutex;
+        std::atomic<int> next_request{0};
+        std::atomic<int> failed{0};
+
+        auto allocations_before = g_allocation_count.load();
+        auto wall_start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> workers;
+        workers.reserve(concurrency);
+        for (int w = 0; w < concurrency; ++w) {
+            workers.emplace_back([&] {
+                // Each worker drives its own client; all of them share the
+                // process-wide async engine, connection pool and caches.
+                auto client = factory.createClient(provider);
+                std::vector<double> local;
+
+                while (next_request.fetch_add(1) < total_requests) {
+                    api::MessageRequest request;
+                    request.message = "Load harness request";
+
+                    auto start = std::chrono::steady_clock::now();
+                    try {
+                        api::ApiResponse response =
+                            stream ? client->sendMessageStream(request, nullptr)
+                                   : client->sendMessage(request);
+                        if (!response.success) {
+                            failed.fetch_add(1);
+                            continue;
+                        }
+                    } catch (const std::exception&) {
+                        failed.fetch_add(1);
+                        continue;
+                    }
+                    local.push_back(std::chrono::duration<double, std::milli>(
+                                        std::chrono::steady_clock::now() - start)
+                                        .count());
+                }
+
+                std::lock_guard<std::mutex> lock(latencies_mutex);
+                latencies_ms.insert(latencies_ms.end(), local.begin(), local.end());
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        auto wall_seconds = std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - wall_start)
+                                .count();
+        auto allocations = g_allocation_count.load() - allocations_before;
+
+        std::sort(latencies_ms.begin(), latencies_ms.end());
+        size_t succeeded = latencies_ms.size();
+
+        std::cout << "Results:\n"
+                  << "  succeeded: " << succeeded << "  failed: " << failed.load() << "\n"
+                  << "  wall time: " << wall_seconds << " s"
+                  << "  throughput: " << (wall_seconds > 0 ? succeeded / wall_seconds : 0)
+                  << " req/s\n"
+                  << "  latency p50: " << percentile(latencies_ms, 0.50) << " ms"
+                  << "  p90: " << percentile(latencies_ms, 0.90) << " ms"
+                  << "  p99: " << percentile(latencies_ms, 0.99) << " ms\n"
+                  << "  heap allocations: " << allocations;
+        if (succeeded > 0) {
+            std::cout << " (" << (allocations / static_cast<double>(succeeded))
+                      << " per request)";
+        }
+        std::cout << "\n"
+                  << "  server: " << server.requestsServed() << " served, "
+                  << server.requestsRateLimited() << " rate-limited\n\n";
+
+        // Give the telemetry aggregator a drain cycle before reporting, so
+        // events from the final requests are counted.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::cout << api::Telemetry::shared().report();
+
+        server.stop();
+        return failed.load() > 0 ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Load test failed: " << e.what() << "\n";
+        server.stop();
+        return 1;
+    }
+}
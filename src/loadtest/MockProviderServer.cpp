@@ -0,0 +1,267 @@
+#include "MockProviderServer.h"
+#include <nlohmann/json.hpp>
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace loadtest {
+
+namespace {
+
+thread_local std::mt19937 t_rng{std::random_device{}()};
+
+void sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+std::string httpResponse(int status, const std::string& status_text,
+                         const std::string& content_type, const std::string& body,
+                         const std::string& extra_headers = "") {
+    return "HTTP/1.1 " + std::to_string(status) + " " + status_text + "\r\n" +
+           "Content-Type: " + content_type + "\r\n" +
+           "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+           extra_headers +
+           "Connection: keep-alive\r\n\r\n" + body;
+}
+
+// One SSE frame the shared SseParser will hand to the client as one event.
+std::string sseEvent(const std::string& data) {
+    return "data: " + data + "\n\n";
+}
+
+} // namespace
+
+MockProviderServer::MockProviderServer(Options options) : options_(std::move(options)) {
+}
+
+MockProviderServer::~MockProviderServer() {
+    stop();
+}
+
+std::string MockProviderServer::start() {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        return {};
+    }
+
+    int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0; // ephemeral
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd_, 64) < 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return {};
+    }
+
+    socklen_t addr_len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &addr_len);
+    port_ = ntohs(addr.sin_port);
+
+    running_.store(true);
+    acceptor_ = std::thread(&MockProviderServer::acceptLoop, this);
+
+    return "http://127.0.0.1:" + std::to_string(port_);
+}
+
+void MockProviderServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    // Closing the listening socket unblocks accept().
+    ::shutdown(listen_fd_, SHUT_RDWR);
+    ::close(listen_fd_);
+    if (acceptor_.joinable()) {
+        acceptor_.join();
+    }
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+std::uint64_t MockProviderServer::requestsServed() const {
+    return served_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t MockProviderServer::requestsRateLimited() const {
+    return rate_limited_.load(std::memory_order_relaxed);
+}
+
+void MockProviderServer::acceptLoop() {
+    while (running_.load()) {
+        int client_fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+        workers_.emplace_back(&MockProviderServer::handleConnection, this, client_fd);
+    }
+}
+
+bool MockProviderServer::readRequest(int client_fd, std::string& method,
+                                     std::string& path, std::string& body) {
+    std::string buffer;
+    char chunk[4096];
+
+    // Read until the end of the header block. Receives time out
+    // periodically so idle keep-alive connections notice shutdown instead
+    // of pinning their worker in recv forever.
+    size_t header_end;
+    while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = ::recv(client_fd, chunk, sizeof(chunk), 0);
+        if (n == 0) {
+            return false;
+        }
+        if (n < 0) {
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && running_.load()) {
+                continue;
+            }
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+
+    auto line_end = buffer.find("\r\n");
+    std::string request_line = buffer.substr(0, line_end);
+    auto first_space = request_line.find(' ');
+    auto second_space = request_line.find(' ', first_space + 1);
+    if (first_space == std::string::npos || second_space == std::string::npos) {
+        return false;
+    }
+    method = request_line.substr(0, first_space);
+    path = request_line.substr(first_space + 1, second_space - first_space - 1);
+
+    size_t content_length = 0;
+    auto cl_pos = buffer.find("Content-Length:");
+    if (cl_pos == std::string::npos) {
+        cl_pos = buffer.find("content-length:");
+    }
+    if (cl_pos != std::string::npos && cl_pos < header_end) {
+        content_length = std::strtoul(buffer.c_str() + cl_pos + 15, nullptr, 10);
+    }
+
+    size_t body_start = header_end + 4;
+    while (buffer.size() - body_start < content_length) {
+        ssize_t n = ::recv(client_fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+
+    body = buffer.substr(body_start, content_length);
+    return true;
+}
+
+void MockProviderServer::handleConnection(int client_fd) {
+    struct timeval timeout = {0, 200000};
+    setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string method;
+    std::string path;
+    std::string body;
+
+    while (running_.load() && readRequest(client_fd, method, path, body)) {
+        if (options_.base_latency_ms > 0 || options_.jitter_ms > 0) {
+            int jitter = options_.jitter_ms > 0
+                             ? static_cast<int>(t_rng() % (options_.jitter_ms + 1))
+                             : 0;
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(options_.base_latency_ms + jitter));
+        }
+
+        if (options_.error_rate > 0.0 &&
+            std::uniform_real_distribution<double>(0.0, 1.0)(t_rng) < options_.error_rate) {
+            rate_limited_.fetch_add(1, std::memory_order_relaxed);
+            respondRateLimited(client_fd);
+            continue;
+        }
+
+        bool stream = body.find("\"stream\":true") != std::string::npos ||
+                      path.find("streamGenerateContent") != std::string::npos;
+        served_.fetch_add(1, std::memory_order_relaxed);
+        respondJson(client_fd, path, stream);
+    }
+
+    ::close(client_fd);
+}
+
+void MockProviderServer::respondRateLimited(int client_fd) {
+    nlohmann::json error = {{"error", {{"type", "rate_limit_error"},
+                                       {"message", "mock rate limit injected"}}}};
+    sendAll(client_fd, httpResponse(429, "Too Many Requests", "application/json",
+                                    error.dump(), "Retry-After: 0\r\n"));
+}
+
+void MockProviderServer::respondJson(int client_fd, const std::string& path, bool stream) {
+    const std::string& text = options_.completion;
+
+    if (!stream) {
+        nlohmann::json body;
+        if (path.find("anthropic") != std::string::npos) {
+            body = {{"id", "msg_mock"},
+                    {"content", nlohmann::json::array({{{"type", "text"}, {"text", text}}})}};
+        } else if (path.find("openai") != std::string::npos) {
+            body = {{"id", "chatcmpl_mock"},
+                    {"choices", nlohmann::json::array(
+                                    {{{"message", {{"role", "assistant"}, {"content", text}}}}})}};
+        } else if (path.find("gemini") != std::string::npos) {
+            body = {{"candidates",
+                     nlohmann::json::array(
+                         {{{"content",
+                            {{"parts", nlohmann::json::array({{{"text", text}}})}}}}})}};
+        } else {
+            body = {{"text", text}};
+        }
+        sendAll(client_fd, httpResponse(200, "OK", "application/json", body.dump()));
+        return;
+    }
+
+    // Split the completion over SSE events in each provider's delta shape.
+    int chunks = options_.stream_chunks > 0 ? options_.stream_chunks : 1;
+    size_t per_chunk = (text.size() + chunks - 1) / chunks;
+    std::string payload;
+    for (size_t offset = 0; offset < text.size(); offset += per_chunk) {
+        std::string slice = text.substr(offset, per_chunk);
+        nlohmann::json event;
+        if (path.find("anthropic") != std::string::npos) {
+            event = {{"type", "content_block_delta"}, {"delta", {{"text", slice}}}};
+        } else if (path.find("openai") != std::string::npos) {
+            event = {{"choices",
+                      nlohmann::json::array({{{"delta", {{"content", slice}}}}})}};
+        } else if (path.find("gemini") != std::string::npos) {
+            event = {{"candidates",
+                      nlohmann::json::array(
+                          {{{"content",
+                             {{"parts", nlohmann::json::array({{{"text", slice}}})}}}}})}};
+        } else {
+            event = {{"event_type", "text-generation"}, {"text", slice}};
+        }
+        payload += sseEvent(event.dump());
+    }
+    if (path.find("openai") != std::string::npos) {
+        payload += sseEvent("[DONE]");
+    }
+
+    sendAll(client_fd, httpResponse(200, "OK", "text/event-stream", payload));
+}
+
+} // namespace loadtest
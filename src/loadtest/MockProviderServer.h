@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace loadtest {
+
+// In-process HTTP/1.1 server emulating the response shapes of the four
+// configured providers, so the full src/api stack can be exercised under
+// load without touching real endpoints or quota. Routing is by URL
+// substring: requests whose path mentions a provider get that provider's
+// body shape, as JSON or as SSE events when the payload asks to stream.
+//
+// Latency and failure are injectable: every response is delayed by
+// base_latency_ms plus a uniform jitter, and a configurable fraction of
+// requests is answered 429 to exercise the retry and rate-limit feedback
+// paths.
+class MockProviderServer {
+public:
+    struct Options {
+        int base_latency_ms = 0;
+        int jitter_ms = 0;
+        // Fraction of requests answered 429 with a Retry-After header.
+        double error_rate = 0.0;
+        // SSE responses split the completion across this many events.
+        int stream_chunks = 8;
+        std::string completion = "This is a mock completion from the load harness.";
+    };
+
+    explicit MockProviderServer(Options options);
+    ~MockProviderServer();
+
+    MockProviderServer(const MockProviderServer&) = delete;
+    MockProviderServer& operator=(const MockProviderServer&) = delete;
+
+    // Binds an ephemeral loopback port and starts accepting; returns the
+    // base URL (http://127.0.0.1:<port>).
+    std::string start();
+
+    void stop();
+
+    std::uint64_t requestsServed() const;
+    std::uint64_t requestsRateLimited() const;
+
+private:
+    void acceptLoop();
+    void handleConnection(int client_fd);
+
+    // One parsed request off the connection; false when the peer closed.
+    bool readRequest(int client_fd, std::string& method, std::string& path,
+                     std::string& body);
+
+    void respondJson(int client_fd, const std::string& path, bool stream);
+    void respondRateLimited(int client_fd);
+
+    Options options_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+    std::thread acceptor_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+    std::atomic<std::uint64_t> served_{0};
+    std::atomic<std::uint64_t> rate_limited_{0};
+};
+
+} // namespace loadtest
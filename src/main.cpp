@@ -1,8 +1,78 @@
 #include "api/factory/ApiFactory.h"
 #include "config/ConfigManager.h"
 #include "api/base/ApiException.h"
+#include "api/base/Metrics.h"
+#include "api/base/Telemetry.h"
 #include <iostream>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <deque>
+#include <map>
+#include <cstring>
+#include <nlohmann/json.hpp>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+std::string testProvider(api::ApiFactory& factory, const std::string& provider) {
+    std::ostringstream out;
+    out << "Testing " << provider << "...\n";
+
+    try {
+        auto client = factory.createClient(provider);
+
+        if (client) {
+            auto info = client->getConnectionInfo();
+            out << "  Provider: " << info["provider"] << "\n";
+            out << "  Base URL: " << info["base_url"] << "\n";
+            out << "  Model: " << info["model"] << "\n";
+            out << "  Connected: " << info["connected"] << "\n";
+            out << "  Max Tokens: " << info["max_tokens"] << "\n";
+            out << "  Temperature: " << info["temperature"] << "\n";
+
+            // Test a simple message
+            api::MessageRequest request;
+            request.message = "Hello! Please respond with just 'Hi there!'";
+            request.max_tokens = 50;
+            request.temperature = 0.7;
+
+            auto response = client->sendMessage(request);
+            if (response.success) {
+                out << "  Response: " << response.content << "\n";
+            } else {
+                out << "  Error: " << response.error_message << "\n";
+            }
+
+            // List available models
+            auto models = client->getAvailableModels();
+            out << "  Available models: ";
+            for (size_t i = 0; i < models.size() && i < 3; ++i) {
+                out << models[i];
+                if (i < std::min(models.size(), static_cast<size_t>(3)) - 1) out << ", ";
+            }
+            if (models.size() > 3) out << "... (+" << (models.size() - 3) << " more)";
+            out << "\n";
+        }
+    } catch (const api::AuthenticationException& e) {
+        out << "  Authentication Error: " << e.what() << "\n";
+        out << "  (Check your API key environment variable)\n";
+    } catch (const api::ConnectionException& e) {
+        out << "  Connection Error: " << e.what() << "\n";
+    } catch (const api::ConfigException& e) {
+        out << "  Configuration Error: " << e.what() << "\n";
+    } catch (const std::exception& e) {
+        out << "  Error: " << e.what() << "\n";
+    }
+
+    out << "\n";
+    return out.str();
+}
 
 void demonstrateApiConnections(api::ApiFactory& factory) {
     std::cout << "=== AI CLI - Multi-API Connection Demo ===\n\n";
@@ -15,57 +85,425 @@ void demonstrateApiConnections(api::ApiFactory& factory) {
     }
     std::cout << "\n\n";
 
-    // Test each provider
+    // Probe every provider concurrently so --test costs the slowest
+    // provider's latency instead of the sum of all four.
+    std::vector<std::future<std::string>> reports;
+    reports.reserve(providers.size());
     for (const auto& provider : providers) {
-        std::cout << "Testing " << provider << "...\n";
+        reports.push_back(std::async(std::launch::async, testProvider,
+                                     std::ref(factory), provider));
+    }
+
+    for (auto& report : reports) {
+        std::cout << report.get();
+    }
+}
 
+// Sends the same request to every configured provider concurrently and
+// returns as soon as the first one answers successfully. Losing transfers
+// are abandoned rather than awaited.
+int raceProviders(api::ApiFactory& factory, const std::string& message) {
+    auto providers = factory.getAvailableProviders();
+    if (providers.empty()) {
+        std::cerr << "No providers configured.\n";
+        return 1;
+    }
+
+    struct RaceState {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+        size_t remaining;
+        std::string winner;
+        api::ApiResponse response;
+    };
+
+    auto state = std::make_shared<RaceState>();
+    state->remaining = providers.size();
+
+    std::cout << "Racing " << providers.size() << " providers...\n";
+
+    for (const auto& provider : providers) {
+        std::shared_ptr<api::IApiClient> client;
         try {
-            auto client = factory.createClient(provider);
+            client = factory.getClient(provider);
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            --state->remaining;
+            std::cerr << "  " << provider << ": " << e.what() << "\n";
+            continue;
+        }
 
-            if (client) {
-                auto info = client->getConnectionInfo();
-                std::cout << "  Provider: " << info["provider"] << "\n";
-                std::cout << "  Base URL: " << info["base_url"] << "\n";
-                std::cout << "  Model: " << info["model"] << "\n";
-                std::cout << "  Connected: " << info["connected"] << "\n";
-                std::cout << "  Max Tokens: " << info["max_tokens"] << "\n";
-                std::cout << "  Temperature: " << info["temperature"] << "\n";
-
-                // Test a simple message
+        std::thread([state, client, provider, message]() {
+            api::ApiResponse response;
+            bool ok = false;
+            try {
                 api::MessageRequest request;
-                request.message = "Hello! Please respond with just 'Hi there!'";
-                request.max_tokens = 50;
-                request.temperature = 0.7;
+                request.message = message;
+                response = client->sendMessage(request);
+                ok = response.success;
+            } catch (const std::exception&) {
+                ok = false;
+            }
 
-                auto response = client->sendMessage(request);
+            std::lock_guard<std::mutex> lock(state->mutex);
+            --state->remaining;
+            if (ok && !state->done) {
+                state->done = true;
+                state->winner = provider;
+                state->response = std::move(response);
+            }
+            state->cv.notify_all();
+        }).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&state] { return state->done || state->remaining == 0; });
+
+    if (!state->done) {
+        std::cerr << "All providers failed.\n";
+        return 1;
+    }
+
+    std::cout << "Winner: " << state->winner << "\n\n";
+    std::cout << state->response.content << "\n";
+
+    // Exit without waiting for (or unwinding under) the losing transfers;
+    // flushing first since _Exit skips stream teardown.
+    std::cout.flush();
+    std::cerr.flush();
+    std::_Exit(0);
+}
+
+// Sends through one provider, hedging to a second when the primary exceeds
+// its latency budget. Providers default to the first two configured.
+int runHedged(api::ApiFactory& factory, const std::string& message,
+              std::string primary, std::string secondary, int hedge_delay_ms) {
+    auto providers = factory.getAvailableProviders();
+    if (primary.empty() && !providers.empty()) {
+        primary = providers.front();
+    }
+    if (secondary.empty()) {
+        for (const auto& provider : providers) {
+            if (provider != primary) {
+                secondary = provider;
+                break;
+            }
+        }
+    }
+    if (primary.empty() || secondary.empty()) {
+        std::cerr << "Hedging needs two configured providers.\n";
+        return 1;
+    }
+
+    std::cout << "Sending via " << primary << " (hedge: " << secondary
+              << " after " << hedge_delay_ms << "ms)...\n";
+
+    api::MessageRequest request;
+    request.message = message;
+
+    api::HedgePolicy policy;
+    policy.secondary_provider = secondary;
+    policy.hedge_delay_ms = hedge_delay_ms;
+
+    auto response = factory.sendMessageHedged(primary, request, policy);
+    if (!response.success) {
+        std::cerr << "Error: "
+                  << (response.error_message.empty() ? response.content
+                                                     : response.error_message)
+                  << "\n";
+        return 1;
+    }
+
+    std::cout << response.content << "\n";
+
+    // A slower hedged transfer may still be running detached; exit without
+    // waiting for it, flushing first since _Exit skips stream teardown.
+    std::cout.flush();
+    std::cerr.flush();
+    std::_Exit(0);
+}
+
+// Streams a JSONL file of message requests through the configured
+// providers with bounded concurrency, emitting one JSONL result per line
+// as each request completes. Lines are read lazily so arbitrarily large
+// batch files never sit in memory.
+int runBatch(api::ApiFactory& factory, const std::string& path,
+             size_t concurrency, const std::string& default_provider) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open batch file: " << path << "\n";
+        return 1;
+    }
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+        std::deque<std::pair<size_t, std::string>> items;
+        size_t limit;
+        bool closed = false;
+    };
+
+    WorkQueue queue;
+    queue.limit = concurrency * 2;
+    std::mutex output_mutex;
+
+    auto worker = [&]() {
+        // Clients are not thread-safe, so each worker constructs its own per
+        // provider instead of sharing the factory's cached ones. Construction
+        // is network-free and the transports (connection pool, caches) are
+        // process-wide, so nothing warm is lost.
+        std::map<std::string, api::ApiClientPtr> clients;
+
+        while (true) {
+            std::pair<size_t, std::string> item;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.not_empty.wait(lock, [&] { return !queue.items.empty() || queue.closed; });
+                if (queue.items.empty()) {
+                    return;
+                }
+                item = std::move(queue.items.front());
+                queue.items.pop_front();
+            }
+            queue.not_full.notify_one();
+
+            nlohmann::json result;
+            result["index"] = item.first;
+
+            try {
+                auto line_json = nlohmann::json::parse(item.second);
+
+                std::string provider = line_json.value("provider", default_provider);
+                if (provider.empty()) {
+                    throw api::ApiException("No provider specified (use a \"provider\" field or --provider)");
+                }
+                result["provider"] = provider;
+
+                api::MessageRequest request;
+                request.message = line_json.value("message", "");
+                request.model = line_json.value("model", "");
+                request.max_tokens = line_json.value("max_tokens", 0);
+                request.temperature = line_json.value("temperature", -1.0);
+                request.context_file = line_json.value("context_file", "");
+
+                auto it = clients.find(provider);
+                if (it == clients.end()) {
+                    it = clients.emplace(provider, factory.createClient(provider)).first;
+                }
+                auto response = it->second->sendMessage(request);
+
+                result["success"] = response.success;
+                result["status_code"] = response.status_code;
                 if (response.success) {
-                    std::cout << "  Response: " << response.content << "\n";
+                    result["content"] = response.content;
                 } else {
-                    std::cout << "  Error: " << response.error_message << "\n";
+                    result["error"] = response.error_message.empty() ? response.content
+                                                                     : response.error_message;
                 }
+            } catch (const std::exception& e) {
+                result["success"] = false;
+                result["error"] = e.what();
+            }
+
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << result.dump() << "\n";
+        }
+    };
 
-                // List available models
-                auto models = client->getAvailableModels();
-                std::cout << "  Available models: ";
-                for (size_t i = 0; i < models.size() && i < 3; ++i) {
-                    std::cout << models[i];
-                    if (i < std::min(models.size(), static_cast<size_t>(3)) - 1) std::cout << ", ";
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < concurrency; ++i) {
+        workers.emplace_back(worker);
+    }
+
+    std::string line;
+    size_t index = 0;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        queue.not_full.wait(lock, [&] { return queue.items.size() < queue.limit; });
+        queue.items.emplace_back(index++, std::move(line));
+        queue.not_empty.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.closed = true;
+    }
+    queue.not_empty.notify_all();
+
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    return 0;
+}
+
+namespace {
+
+bool writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Reads until the first newline or EOF; requests and responses are one
+// JSON document per line.
+std::string readLine(int fd) {
+    std::string line;
+    char buffer[4096];
+    while (line.find('\n') == std::string::npos) {
+        ssize_t n = ::read(fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            break;
+        }
+        line.append(buffer, static_cast<size_t>(n));
+    }
+    return line;
+}
+
+} // namespace
+
+// Daemon mode: one warm process keeps the factory, pooled connections and
+// caches alive, and serves requests over a Unix domain socket so interactive
+// callers skip process start, config parse and TLS handshakes entirely.
+int runServe(api::ApiFactory& factory, const std::string& socket_path) {
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        std::cerr << "Failed to create socket: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Socket path too long: " << socket_path << "\n";
+        ::close(listen_fd);
+        return 1;
+    }
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    ::unlink(socket_path.c_str());
+    if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd, 16) < 0) {
+        std::cerr << "Failed to bind " << socket_path << ": " << std::strerror(errno) << "\n";
+        ::close(listen_fd);
+        return 1;
+    }
+
+    std::cout << "Serving on " << socket_path << "\n";
+
+    while (true) {
+        int client_fd = ::accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            continue;
+        }
+
+        std::thread([&factory, client_fd]() {
+            nlohmann::json result;
+            try {
+                auto request_json = nlohmann::json::parse(readLine(client_fd));
+
+                std::string provider = request_json.value("provider", "");
+                if (provider.empty()) {
+                    auto providers = factory.getAvailableProviders();
+                    if (providers.empty()) {
+                        throw api::ApiException("No providers configured");
+                    }
+                    provider = providers.front();
                 }
-                if (models.size() > 3) std::cout << "... (+" << (models.size() - 3) << " more)";
-                std::cout << "\n";
+                result["provider"] = provider;
+
+                api::MessageRequest request;
+                request.message = request_json.value("message", "");
+                request.model = request_json.value("model", "");
+                request.max_tokens = request_json.value("max_tokens", 0);
+                request.temperature = request_json.value("temperature", -1.0);
+                request.context_file = request_json.value("context_file", "");
+
+                // Connections are served concurrently and clients are not
+                // thread-safe, so each connection gets its own. The warmth
+                // that matters — pooled connections, TLS sessions, caches —
+                // lives in the process-wide transports, not the client.
+                auto response = factory.createClient(provider)->sendMessage(request);
+
+                result["success"] = response.success;
+                result["status_code"] = response.status_code;
+                if (response.success) {
+                    result["content"] = response.content;
+                } else {
+                    result["error"] = response.error_message.empty() ? response.content
+                                                                     : response.error_message;
+                }
+            } catch (const std::exception& e) {
+                result["success"] = false;
+                result["error"] = e.what();
             }
-        } catch (const api::AuthenticationException& e) {
-            std::cout << "  Authentication Error: " << e.what() << "\n";
-            std::cout << "  (Check your API key environment variable)\n";
-        } catch (const api::ConnectionException& e) {
-            std::cout << "  Connection Error: " << e.what() << "\n";
-        } catch (const api::ConfigException& e) {
-            std::cout << "  Configuration Error: " << e.what() << "\n";
-        } catch (const std::exception& e) {
-            std::cout << "  Error: " << e.what() << "\n";
-        }
 
-        std::cout << "\n";
+            writeAll(client_fd, result.dump() + "\n");
+            ::close(client_fd);
+        }).detach();
+    }
+}
+
+// Thin client mode: forwards one request to a running daemon and prints the
+// answer. Deliberately does not load configuration — paying the config
+// parse here would defeat the point of the daemon.
+int runSend(const std::string& socket_path, const std::string& message,
+            const std::string& provider) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Failed to create socket: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "Failed to connect to " << socket_path
+                  << " — is the daemon running? (start one with --serve)\n";
+        ::close(fd);
+        return 1;
+    }
+
+    nlohmann::json request;
+    request["message"] = message;
+    if (!provider.empty()) {
+        request["provider"] = provider;
+    }
+
+    if (!writeAll(fd, request.dump() + "\n")) {
+        std::cerr << "Failed to send request.\n";
+        ::close(fd);
+        return 1;
+    }
+    ::shutdown(fd, SHUT_WR);
+
+    auto line = readLine(fd);
+    ::close(fd);
+
+    try {
+        auto result = nlohmann::json::parse(line);
+        if (result.value("success", false)) {
+            std::cout << result.value("content", "") << "\n";
+            return 0;
+        }
+        std::cerr << "Error: " << result.value("error", "unknown") << "\n";
+        return 1;
+    } catch (const nlohmann::json::exception&) {
+        std::cerr << "Malformed response from daemon.\n";
+        return 1;
     }
 }
 
@@ -76,6 +514,17 @@ void printUsage(const char* program_name) {
     std::cout << "  --test             Test all API connections\n";
     std::cout << "  --list-providers   List available providers\n";
     std::cout << "  --provider <name>  Test specific provider only\n";
+    std::cout << "  --stats            Dump per-provider transfer timing stats on exit\n";
+    std::cout << "  --telemetry        Dump request lifecycle telemetry on exit\n";
+    std::cout << "  --race <message>   Send message to all providers, print first success\n";
+    std::cout << "  --hedge <message>  Send via --provider, hedge to --hedge-to on slow primary\n";
+    std::cout << "  --hedge-to <name>  Secondary provider for --hedge (default: next configured)\n";
+    std::cout << "  --hedge-delay <ms> Latency budget before hedging (default: 1000)\n";
+    std::cout << "  --batch <file>     Stream a JSONL file of requests, emit JSONL results\n";
+    std::cout << "  --serve <socket>   Run as a warm daemon on a Unix domain socket\n";
+    std::cout << "  --send <message>   Forward one request to a running daemon\n";
+    std::cout << "  --socket <path>    Socket for --send (default: /tmp/ai-cli.sock)\n";
+    std::cout << "  --jobs <n>         Concurrency for --batch (default: 4)\n";
     std::cout << "  --help             Show this help message\n\n";
     std::cout << "Examples:\n";
     std::cout << "  " << program_name << " --test\n";
@@ -87,6 +536,20 @@ int main(int argc, char* argv[]) {
     std::string config_file = "./config.local";
     bool test_mode = false;
     bool list_providers = false;
+    bool show_stats = false;
+    bool show_telemetry = false;
+    bool race_mode = false;
+    std::string race_message;
+    bool hedge_mode = false;
+    std::string hedge_message;
+    std::string hedge_secondary;
+    int hedge_delay_ms = 1000;
+    std::string batch_file;
+    size_t batch_jobs = 4;
+    std::string serve_socket;
+    std::string send_message;
+    bool send_mode = false;
+    std::string send_socket = "/tmp/ai-cli.sock";
     std::string specific_provider;
 
     // Parse command line arguments
@@ -100,6 +563,31 @@ int main(int argc, char* argv[]) {
             config_file = argv[++i];
         } else if (arg == "--test") {
             test_mode = true;
+        } else if (arg == "--stats") {
+            show_stats = true;
+        } else if (arg == "--telemetry") {
+            show_telemetry = true;
+        } else if (arg == "--race" && i + 1 < argc) {
+            race_mode = true;
+            race_message = argv[++i];
+        } else if (arg == "--hedge" && i + 1 < argc) {
+            hedge_mode = true;
+            hedge_message = argv[++i];
+        } else if (arg == "--hedge-to" && i + 1 < argc) {
+            hedge_secondary = argv[++i];
+        } else if (arg == "--hedge-delay" && i + 1 < argc) {
+            hedge_delay_ms = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--batch" && i + 1 < argc) {
+            batch_file = argv[++i];
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            batch_jobs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--serve" && i + 1 < argc) {
+            serve_socket = argv[++i];
+        } else if (arg == "--send" && i + 1 < argc) {
+            send_mode = true;
+            send_message = argv[++i];
+        } else if (arg == "--socket" && i + 1 < argc) {
+            send_socket = argv[++i];
         } else if (arg == "--list-providers") {
             list_providers = true;
         } else if (arg == "--provider" && i + 1 < argc) {
@@ -112,6 +600,12 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    // The thin client talks only to the daemon; loading configuration here
+    // would re-pay the startup cost the daemon exists to amortize.
+    if (send_mode) {
+        return runSend(send_socket, send_message, specific_provider);
+    }
+
     try {
         // Initialize configuration
         std::cout << "Loading configuration from: " << config_file << "\n";
@@ -129,6 +623,25 @@ int main(int argc, char* argv[]) {
             return 0;
         }
 
+        if (!serve_socket.empty()) {
+            // Long-lived process: pick up config edits without a restart.
+            config_manager.startWatching();
+            return runServe(factory, serve_socket);
+        }
+
+        if (race_mode) {
+            return raceProviders(factory, race_message);
+        }
+
+        if (hedge_mode) {
+            return runHedged(factory, hedge_message, specific_provider,
+                             hedge_secondary, hedge_delay_ms);
+        }
+
+        if (!batch_file.empty()) {
+            return runBatch(factory, batch_file, batch_jobs, specific_provider);
+        }
+
         if (test_mode) {
             if (!specific_provider.empty()) {
                 if (!factory.isProviderSupported(specific_provider)) {
@@ -162,6 +675,16 @@ int main(int argc, char* argv[]) {
             std::cout << "Use --help for usage information.\n";
         }
 
+        if (show_stats) {
+            std::cout << "\n=== Transfer Timing Stats ===\n";
+            std::cout << api::MetricsRegistry::shared().report();
+        }
+
+        if (show_telemetry) {
+            std::cout << "\n=== Request Telemetry ===\n";
+            std::cout << api::Telemetry::shared().report();
+        }
+
     } catch (const api::ConfigException& e) {
         std::cerr << "Configuration Error: " << e.what() << std::endl;
         std::cerr << "\nPlease ensure:\n";